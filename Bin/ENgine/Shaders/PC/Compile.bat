@@ -5,6 +5,9 @@ fxc /E PS /T ps_4_0 /Zi /Od /Fo screen_ps.shd screen.shader
 fxc /E VS /T vs_4_0 /Zi /Od /Fo triangle_vs.shd triangle.shader
 fxc /E PS /T ps_4_0 /Zi /Od /Fo triangle_ps.shd triangle.shader
 
+fxc /E VS /T vs_4_0 /Zi /Od /Fo triangle_inst_vs.shd triangle_inst.shader
+fxc /E PS /T ps_4_0 /Zi /Od /Fo triangle_inst_ps.shd triangle_inst.shader
+
 fxc /E VS /T vs_4_0 /Zi /Od /Fo sh_triangle_vs.shd sh_triangle.shader
 fxc /E PS /T ps_4_0 /Zi /Od /Fo sh_triangle_ps.shd sh_triangle.shader
 
@@ -41,6 +44,9 @@ fxc /E PS /T ps_4_0 /Zi /Od /Fo particle_ps.shd particle.shader
 fxc /E VS /T vs_4_0 /Zi /Od /Fo sprite_vs.shd sprite.shader
 fxc /E PS /T ps_4_0 /Zi /Od /Fo sprite_ps.shd sprite.shader
 
+fxc /E VS /T vs_4_0 /Zi /Od /Fo sprite_batch_vs.shd sprite_batch.shader
+fxc /E PS /T ps_4_0 /Zi /Od /Fo sprite_batch_ps.shd sprite_batch.shader
+
 fxc /E VS /T vs_4_0 /Zi /Od /Fo triangle_simplest_vs.shd triangle_simplest.shader
 fxc /E PS /T ps_4_0 /Zi /Od /Fo triangle_simplest_ps.shd triangle_simplest.shader
 
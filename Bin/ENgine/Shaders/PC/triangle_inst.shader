@@ -0,0 +1,53 @@
+
+cbuffer vs_params : register( b0 )
+{
+	matrix view_proj;
+};
+
+struct VS_INPUT
+{
+	float3 position : POSITION;
+	float2 texCoord : TEXCOORD0;
+	float3 normal : TEXCOORD1;
+	float4 trans0 : TEXCOORD2;
+	float4 trans1 : TEXCOORD3;
+	float4 trans2 : TEXCOORD4;
+	float4 trans3 : TEXCOORD5;
+	float4 color : COLOR0;
+};
+
+struct PS_INPUT
+{
+	float4 pos : SV_POSITION;
+	float2 texCoord : TEXCOORD0;
+	float3 normal : TEXCOORD1;
+	float4 color : COLOR0;
+};
+
+Texture2D diffuseMap : register(t0);
+SamplerState samLinear : register(s0);
+
+PS_INPUT VS( VS_INPUT input )
+{
+	PS_INPUT output = (PS_INPUT)0;
+
+	float4x4 trans = float4x4(input.trans0, input.trans1, input.trans2, input.trans3);
+
+	float4 pos = mul(float4(input.position, 1.0f), trans);
+	output.pos = mul(pos, view_proj);
+
+	output.normal = normalize(mul(input.normal, (float3x3)trans));
+	output.texCoord = input.texCoord;
+	output.color = input.color;
+
+	return output;
+}
+
+float4 PS( PS_INPUT input) : SV_Target
+{
+	float3 lightDir = float3(0.5f, 0.3f, 0.3f);
+	lightDir = normalize(lightDir);
+	float light = 0.6f + 0.4f * saturate(dot(lightDir, input.normal));
+
+	return input.color * (0.3f + diffuseMap.Sample(samLinear, input.texCoord) * 0.7f) * light;
+}
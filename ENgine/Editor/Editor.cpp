@@ -1538,6 +1538,7 @@ namespace Oak
 			editorDrawer.DrawSkyBox();
 		}
 
+		root.render.ExecutePool(Scene::cullingLevel, dt);
 		root.render.ExecutePool(0, dt);
 		root.render.ExecutePool(10, dt);
 		root.render.ExecutePool(100, dt);
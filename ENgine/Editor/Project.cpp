@@ -133,6 +133,11 @@ namespace Oak
 
 			holder->scene->Save(path);
 
+			char binaryPath[1024];
+			Scene::GetBinaryPath(path, binaryPath, 1024);
+
+			holder->scene->SaveBinary(binaryPath);
+
 			int len = (int)strlen(path);
 
 			path[len - 2] = 'n';
@@ -183,11 +183,15 @@ namespace Oak
 		}
 #endif
 
+		root.assets.lock.Enter();
+
 		if (root.assets.assetsMap.count(path) > 0)
 		{
 			root.assets.assetsMap[path]->asset = nullptr;
 		}
 
+		root.assets.lock.UnLock();
+
 		delete this;
 	}
 }
\ No newline at end of file
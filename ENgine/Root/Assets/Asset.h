@@ -5,6 +5,7 @@
 #include "Support/PointerRef.h"
 #include "Support/MetaData.h"
 #include "Root/TaskExecutor/TaskExecutor.h"
+#include <atomic>
 
 #ifdef OAK_EDITOR
 #include <sys/stat.h>
@@ -25,7 +26,7 @@ namespace Oak
 		#endif
 
 		eastl::string path;
-		int refCounter = 0;
+		std::atomic<int> refCounter{ 0 };
 
 #ifdef OAK_EDITOR
 		TaskExecutor::SingleTaskPool* taskPool = nullptr;
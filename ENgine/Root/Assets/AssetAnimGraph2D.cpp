@@ -832,14 +832,29 @@ namespace Oak
 			if (loader.Read("path", path))
 			{
 				*this = Oak::root.assets.GetAssetRef<AssetAnimGraph2DRef>(path);
-				Reset();
 			}
 
 			loader.LeaveBlock();
 		}
 	}
 
+	void AssetAnimGraph2DRef::LoadData(BinaryReader& loader)
+	{
+		eastl::string path;
+		loader.Read(path);
+
+		if (!path.empty())
+		{
+			*this = Oak::root.assets.GetAssetRef<AssetAnimGraph2DRef>(path);
+		}
+	}
+
 #ifdef OAK_EDITOR
+	void AssetAnimGraph2DRef::SaveData(BinaryWriter& saver)
+	{
+		saver.Write(Get() ? Get()->GetPath().c_str() : "");
+	}
+
 	void AssetAnimGraph2DRef::SaveData(JsonWriter& saver, const char* name)
 	{
 		if (Get())
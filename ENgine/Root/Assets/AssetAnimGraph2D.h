@@ -130,9 +130,11 @@ namespace Oak
 		Math::Vector2 GetSize();
 
 		void LoadData(JsonReader& loader, const char* name);
+		void LoadData(BinaryReader& loader);
 
 	#ifdef OAK_EDITOR
 		void SaveData(JsonWriter& saver, const char* name);
+		void SaveData(BinaryWriter& saver);
 	#endif
 	};
 }
\ No newline at end of file
@@ -464,7 +464,33 @@ namespace Oak
 		}
 	}
 
+	void AssetTextureRef::LoadData(BinaryReader& loader)
+	{
+		eastl::string path;
+		loader.Read(path);
+
+		int slice = -1;
+		int anim = -1;
+		loader.Read(slice);
+		loader.Read(anim);
+
+		if (!path.empty())
+		{
+			*this = Oak::root.assets.GetAssetRef<AssetTextureRef>(path);
+
+			sliceIndex = slice;
+			animIndex = anim;
+		}
+	}
+
 	#ifdef OAK_EDITOR
+	void AssetTextureRef::SaveData(BinaryWriter& saver)
+	{
+		saver.Write(Get() ? Get()->GetPath().c_str() : "");
+		saver.Write(sliceIndex);
+		saver.Write(animIndex);
+	}
+
 	void AssetTextureRef::SaveData(JsonWriter& saver, const char* name)
 	{
 		if (Get())
@@ -98,9 +98,11 @@ namespace Oak
 		bool IsAnimFinished();
 
 		void LoadData(JsonReader& loader, const char* name);
+		void LoadData(BinaryReader& loader);
 
 	#ifdef OAK_EDITOR
 		void SaveData(JsonWriter& saver, const char* name);
+		void SaveData(BinaryWriter& saver);
 		void ImGuiImage(float size);
 	#endif
 
@@ -1,4 +1,5 @@
 #include "Root/Root.h"
+#include "Support/Timer.h"
 
 namespace Oak
 {
@@ -7,7 +8,39 @@ namespace Oak
 
 	void Assets::Init()
 	{
+		mainThread = std::this_thread::get_id();
+	}
+
+	bool Assets::LoadPendingAssets(double deadline)
+	{
+		lock.Enter();
+
+		int index = 0;
+
+		while (index < pendingAssets.size())
+		{
+			AssetHolder* holder = pendingAssets[index];
+			index++;
+
+			// asset could be released while it was waiting
+			if (holder->asset && !holder->loaded)
+			{
+				holder->GetAsset();
+
+				if (Timer::GetTime() > deadline)
+				{
+					break;
+				}
+			}
+		}
+
+		pendingAssets.erase(pendingAssets.begin(), pendingAssets.begin() + index);
+
+		bool allLoaded = pendingAssets.empty();
+
+		lock.UnLock();
 
+		return allLoaded;
 	}
 
 	void Assets::LoadAssets()
@@ -188,6 +221,7 @@ namespace Oak
 		#endif
 
 		assetsMap.clear();
+		pendingAssets.clear();
 		rootFolder.Clear();
 	}
 
@@ -4,6 +4,7 @@
 #include <EASTL/vector.h>
 #include "Support/ThreadExecutor.h"
 #include <atomic>
+#include <thread>
 #include "AssetTexture.h"
 #include "AssetAnimGraph2D.h"
 
@@ -18,6 +19,7 @@ namespace Oak
 		struct AssetHolder
 		{
 			Asset* asset = nullptr;
+			bool loaded = false;
 			eastl::string name;
 			eastl::string ext;
 			eastl::string fullName;
@@ -27,13 +29,27 @@ namespace Oak
 				return assetCreation[ext].c_str();
 			}
 
-			Asset* GetAsset()
+			// creation of an object doesn't touch a device, so it can be done on a loading thread
+			void CreateAsset()
 			{
 				if (asset == nullptr)
 				{
 					ClassFactoryAsset* decl = ClassFactoryAsset::Find(GetAssetType());
 
 					asset = decl->Create(_FL_);
+					asset->SetPath(fullName.c_str());
+					loaded = false;
+				}
+			}
+
+			Asset* GetAsset()
+			{
+				CreateAsset();
+
+				if (!loaded)
+				{
+					loaded = true;
+
 					asset->Init();
 					asset->SetPath(fullName.c_str());
 					asset->Reload();
@@ -81,6 +97,11 @@ namespace Oak
 
 		eastl::map<eastl::string, AssetHolder*> assetsMap;
 
+		CriticalSection lock;
+
+		std::thread::id mainThread;
+		eastl::vector<AssetHolder*> pendingAssets;
+
 		#ifdef OAK_EDITOR
 		std::atomic<bool> scanning;
 		std::atomic<bool> needRescan;
@@ -99,14 +120,47 @@ namespace Oak
 		template<class T>
 		T GetAssetRef(eastl::string& path)
 		{
-			if (assetsMap.count(path) > 0)
+			// refs are requested by scenes which are streaming on a loading thread
+			lock.Enter();
+
+			T ref;
+			auto iter = assetsMap.find(path);
+
+			if (iter != assetsMap.end())
 			{
-				return assetsMap[path]->GetAssetRef<T>();
+				AssetHolder* holder = iter->second;
+
+				// loading thread only creates an asset, it is loaded on a main thread before scene is applied
+				if (std::this_thread::get_id() != mainThread)
+				{
+					if (!holder->asset)
+					{
+						holder->CreateAsset();
+						pendingAssets.push_back(holder);
+					}
+
+					ref = T(holder->asset, _FL_);
+				}
+				else
+				{
+					ref = holder->GetAssetRef<T>();
+				}
 			}
 
-			return T();
+			lock.UnLock();
+
+			return ref;
 		};
 
+		/**
+		\brief Load assets which were requested by a loading thread
+
+		\param[in] deadline Time after which loading is stopped
+
+		\return True will be returned if all requested assets were loaded
+		*/
+		bool LoadPendingAssets(double deadline);
+
 		#ifdef OAK_EDITOR
 		void LoadAssets(const char* path, Folder* folder, bool update);
 		void ObserveRoot();
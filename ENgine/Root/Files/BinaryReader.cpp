@@ -0,0 +1,100 @@
+#include "BinaryReader.h"
+#include "Root/Root.h"
+
+namespace Oak
+{
+	bool BinaryReader::Open(const char* name)
+	{
+		failed = false;
+
+		if (file.Load(name))
+		{
+			ptr = file.GetData();
+			end = ptr + file.GetSize();
+
+			return true;
+		}
+
+		ptr = end = nullptr;
+
+		return false;
+	}
+
+	bool BinaryReader::Read(void* data, int size)
+	{
+		if (failed || size < 0 || end - ptr < size)
+		{
+			failed = true;
+			return false;
+		}
+
+		memcpy(data, ptr, size);
+		ptr += size;
+
+		return true;
+	}
+
+	bool BinaryReader::Read(bool& val)
+	{
+		uint8_t tmp = 0;
+
+		if (Read(&tmp, 1))
+		{
+			val = tmp != 0;
+			return true;
+		}
+
+		return false;
+	}
+
+	bool BinaryReader::Read(int& val)
+	{
+		return Read(&val, sizeof(int));
+	}
+
+	bool BinaryReader::Read(uint16_t& val)
+	{
+		return Read(&val, sizeof(uint16_t));
+	}
+
+	bool BinaryReader::Read(uint32_t& val)
+	{
+		return Read(&val, sizeof(uint32_t));
+	}
+
+	bool BinaryReader::Read(float& val)
+	{
+		return Read(&val, sizeof(float));
+	}
+
+	bool BinaryReader::Read(eastl::string& val)
+	{
+		uint32_t len = 0;
+
+		if (!Read(len) || (uint32_t)(end - ptr) < len)
+		{
+			failed = true;
+			return false;
+		}
+
+		val.assign((const char*)ptr, (const char*)ptr + len);
+		ptr += len;
+
+		return true;
+	}
+
+	bool BinaryReader::Read(Math::Vector3& val)
+	{
+		return Read(&val.x, sizeof(float) * 3);
+	}
+
+	bool BinaryReader::Read(Color& val)
+	{
+		return Read(&val.r, sizeof(float) * 4);
+	}
+
+	bool BinaryReader::IsFailed()
+	{
+		return failed;
+	}
+}
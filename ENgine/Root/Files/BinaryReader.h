@@ -0,0 +1,58 @@
+#pragma once
+
+#include "Support/Support.h"
+#include <EASTL/string.h>
+#include "FileInMemory.h"
+
+namespace Oak
+{
+	/**
+	\ingroup gr_code_root_files
+	*/
+
+	/**
+	\brief BinaryReader
+
+	This is a helper class for reading binary file which was written via BinaryWriter.
+	Whole file is loaded into memory, reading out of the end of a file is marked as failure.
+
+	*/
+
+	class BinaryReader
+	{
+		#ifndef DOXYGEN_SKIP
+		FileInMemory file;
+		uint8_t* ptr = nullptr;
+		uint8_t* end = nullptr;
+		bool failed = false;
+		#endif
+
+	public:
+
+		/**
+		\brief Load binary file
+
+		\param[in] name Full path of a file
+
+		\return True will be returned if file successfully loaded. Otherwise it returns false.
+		*/
+		bool Open(const char* name);
+
+		bool Read(void* data, int size);
+		bool Read(bool& val);
+		bool Read(int& val);
+		bool Read(uint16_t& val);
+		bool Read(uint32_t& val);
+		bool Read(float& val);
+		bool Read(eastl::string& val);
+		bool Read(Math::Vector3& val);
+		bool Read(Color& val);
+
+		/**
+		\brief Check if reading out of the end of a file was requested
+
+		\return True will be returned if there was reading out of the end of a file
+		*/
+		bool IsFailed();
+	};
+}
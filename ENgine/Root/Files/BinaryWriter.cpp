@@ -0,0 +1,85 @@
+#include "BinaryWriter.h"
+#include "Root/Root.h"
+
+namespace Oak
+{
+	BinaryWriter::~BinaryWriter()
+	{
+		Close();
+	}
+
+	bool BinaryWriter::Start(const char* name)
+	{
+		Close();
+
+		file = root.files.FileOpen(name, "wb");
+
+		return file != nullptr;
+	}
+
+	void BinaryWriter::Write(const void* data, int size)
+	{
+		if (file && size > 0)
+		{
+			fwrite(data, size, 1, file);
+		}
+	}
+
+	void BinaryWriter::Write(bool val)
+	{
+		uint8_t tmp = val ? 1 : 0;
+		Write(&tmp, 1);
+	}
+
+	void BinaryWriter::Write(int val)
+	{
+		Write(&val, sizeof(int));
+	}
+
+	void BinaryWriter::Write(uint16_t val)
+	{
+		Write(&val, sizeof(uint16_t));
+	}
+
+	void BinaryWriter::Write(uint32_t val)
+	{
+		Write(&val, sizeof(uint32_t));
+	}
+
+	void BinaryWriter::Write(float val)
+	{
+		Write(&val, sizeof(float));
+	}
+
+	void BinaryWriter::Write(const char* val)
+	{
+		uint32_t len = val ? (uint32_t)strlen(val) : 0;
+
+		Write(len);
+		Write(val, len);
+	}
+
+	void BinaryWriter::Write(eastl::string& val)
+	{
+		Write(val.c_str());
+	}
+
+	void BinaryWriter::Write(Math::Vector3& val)
+	{
+		Write(&val.x, sizeof(float) * 3);
+	}
+
+	void BinaryWriter::Write(Color& val)
+	{
+		Write(&val.r, sizeof(float) * 4);
+	}
+
+	void BinaryWriter::Close()
+	{
+		if (file)
+		{
+			fclose(file);
+			file = nullptr;
+		}
+	}
+}
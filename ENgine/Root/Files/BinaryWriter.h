@@ -0,0 +1,58 @@
+#pragma once
+
+#include <stdio.h>
+#include "Support/Support.h"
+#include <stdint.h>
+#include <EASTL/string.h>
+
+namespace Oak
+{
+	/**
+	\ingroup gr_code_root_files
+	*/
+
+	/**
+	\brief BinaryWriter
+
+	This is a helper class for writing binary file. Values are written packed without any names.
+	Strings are written as length followed by characters.
+
+	*/
+
+	class BinaryWriter
+	{
+		#ifndef DOXYGEN_SKIP
+		FILE* file = nullptr;
+		#endif
+
+	public:
+
+		BinaryWriter() = default;
+		~BinaryWriter();
+
+		/**
+		\brief Start writing a binary file
+
+		\param[in] name Full path of a file
+
+		\return True will be returned if file was successfully opened for writing. Otherwise it returns false.
+		*/
+		bool Start(const char* name);
+
+		void Write(const void* data, int size);
+		void Write(bool val);
+		void Write(int val);
+		void Write(uint16_t val);
+		void Write(uint32_t val);
+		void Write(float val);
+		void Write(const char* val);
+		void Write(eastl::string& val);
+		void Write(Math::Vector3& val);
+		void Write(Color& val);
+
+		/**
+		\brief Finish writing of a file
+		*/
+		void Close();
+	};
+}
@@ -10,9 +10,9 @@ namespace Oak
 	{
 		Release();
 
-		const char* modeStr[] = { "rb", "w", "wb", "a", "ab" };
+		const char* modeStr[] = { "rb", "wb", "w", "ab", "a" };
 
-		FILE* file = root.files.FileOpen(name, modeStr[(int)mode]);
+		file = root.files.FileOpen(name, modeStr[(int)mode]);
 
 		if (file)
 		{
@@ -112,6 +112,7 @@ namespace Oak
 		if (file)
 		{
 			fclose(file);
+			file = nullptr;
 		}
 	}
 }
\ No newline at end of file
@@ -21,12 +21,12 @@ namespace Oak
 	class File
 	{
 		#ifndef DOXYGEN_SKIP
-		uint8_t* data_ptr;
-		uint8_t* ptr;
+		uint8_t* data_ptr = nullptr;
+		uint8_t* ptr = nullptr;
 
-		FILE* file;
+		FILE* file = nullptr;
 	
-		uint32_t size;
+		uint32_t size = 0;
 		#endif
 
 	public:
@@ -4,6 +4,8 @@
 #include <stdio.h>
 #include "JsonReader.h"
 #include "JsonWriter.h"
+#include "BinaryReader.h"
+#include "BinaryWriter.h"
 
 namespace Oak
 {
@@ -24,6 +26,7 @@ namespace Oak
 		friend class File;
 		friend class FileInMemory;
 		friend class JsonWriter;
+		friend class BinaryWriter;
 
 		FILE* FileOpenInner(const char* path, const char* mode);
 
@@ -27,9 +27,13 @@ namespace Oak
 
 		if (root)
 		{
+			curDepth = 0;
 			nodes[curDepth] = root;
+			cursors[curDepth] = nullptr;
 			curNode = nodes[curDepth];
 
+			arrayCursors.clear();
+
 			return true;
 		}
 
@@ -55,28 +59,47 @@ namespace Oak
 
 	bool JsonReader::EnterBlock(const char* name)
 	{
-		nodes[curDepth +1] = FindValue(name);
+		json_value* node = FindValue(name);
 
-		if (nodes[curDepth +1])
+		if (node)
 		{
-			if (nodes[curDepth +1]->type == JSON_OBJECT)
+			if (node->type == JSON_OBJECT)
 			{
 				curDepth++;
+				nodes[curDepth] = node;
+				cursors[curDepth] = nullptr;
 				curNode = nodes[curDepth];
 
 				return true;
 			}
 			else
-			if (nodes[curDepth +1]->type == JSON_ARRAY)
+			if (node->type == JSON_ARRAY)
 			{
-				if (nodes[curDepth +1]->first_child)
+				// every EnterBlock of an array enters next element, cursor is dropped when
+				// array is exhausted so an array can be iterated again
+				json_value* item = node->first_child;
+
+				auto cursor = arrayCursors.find(node);
+
+				if (cursor != arrayCursors.end())
+				{
+					item = cursor->second;
+				}
+
+				if (item)
 				{
 					curDepth++;
-					nodes[curDepth] = nodes[curDepth]->first_child;
+					nodes[curDepth] = item;
+					cursors[curDepth] = nullptr;
 					curNode = nodes[curDepth];
 
 					return true;
 				}
+
+				if (cursor != arrayCursors.end())
+				{
+					arrayCursors.erase(cursor);
+				}
 			}
 		}
 
@@ -89,7 +112,7 @@ namespace Oak
 
 		if (nodes[curDepth]->parent->type == JSON_ARRAY)
 		{
-			nodes[curDepth]->parent->first_child = nodes[curDepth]->next_sibling;
+			arrayCursors[nodes[curDepth]->parent] = nodes[curDepth]->next_sibling;
 		}
 	
 		curDepth--;
@@ -473,10 +496,23 @@ namespace Oak
 			return curNode;
 		}
 
-		for (json_value *it = curNode->first_child; it; it = it->next_sibling)
+		json_value* cursor = cursors[curDepth];
+		json_value* start = cursor ? cursor->next_sibling : curNode->first_child;
+
+		for (json_value* it = start; it; it = it->next_sibling)
+		{
+			if (it->name && StringUtils::IsEqual(name, it->name))
+			{
+				cursors[curDepth] = it;
+				return it;
+			}
+		}
+
+		for (json_value* it = curNode->first_child; it != start; it = it->next_sibling)
 		{
-			if (StringUtils::IsEqual(name, it->name))
+			if (it->name && StringUtils::IsEqual(name, it->name))
 			{
+				cursors[curDepth] = it;
 				return it;
 			}
 		}
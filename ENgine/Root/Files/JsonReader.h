@@ -4,6 +4,7 @@
 #include "json.h"
 #include "Support/Support.h"
 #include <EASTL/string.h>
+#include <EASTL/hash_map.h>
 #include "FileInMemory.h"
 
 namespace Oak
@@ -15,7 +16,8 @@ namespace Oak
 	/**
 	\brief JSONReader
 
-	This is a helper class for reading kson file
+	This is a helper class for reading kson file. Reading doesn't modify parsed document. Lookup of a key
+	starts from a sibling of previously found key, so reading keys in order of a file is linear.
 
 	*/
 
@@ -29,7 +31,10 @@ namespace Oak
 
 		int curDepth = 0;
 		json_value* nodes[32];
+		json_value* cursors[32];
 		json_value* curNode = nullptr;
+
+		eastl::hash_map<json_value*, json_value*> arrayCursors;
 		#endif
 
 	public:
@@ -208,8 +208,8 @@ namespace Oak
 
 		params[0] = Math::Vector4((float)root.render.GetDevice()->GetWidth(), (float)root.render.GetDevice()->GetHeight(), 0.5f, 0.0f);
 
-		root.fonts.fntProg->SetVector(ShaderType::Vertex, "desc", &params[0], 1);
-		root.fonts.fntProg->SetMatrix(ShaderType::Vertex, "transform", &tmp, 1);
+		root.fonts.fntProg->SetVector(root.fonts.fntDesc, &params[0], 1);
+		root.fonts.fntProg->SetMatrix(root.fonts.fntTransform, &tmp, 1);
 
 		if (font_scale > 1.01f)
 		{
@@ -223,8 +223,8 @@ namespace Oak
 		root.render.GetDevice()->SetVertexDecl(root.fonts.vdecl);
 		root.render.GetDevice()->SetVertexBuffer(0, root.fonts.vbuffer);
 
-		root.fonts.fntProg->SetTexture(ShaderType::Pixel, "diffuseMap", tex);
-		root.fonts.fntProg->SetVector(ShaderType::Pixel, "color", (Math::Vector4*)&color, 1);
+		root.fonts.fntProg->SetTexture(root.fonts.fntDiffuseMap, tex);
+		root.fonts.fntProg->SetVector(root.fonts.fntColor, (Math::Vector4*)&color, 1);
 
 		float scr_x = 0;
 
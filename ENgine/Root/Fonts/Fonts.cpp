@@ -23,6 +23,10 @@ namespace Oak
 	bool Fonts::Init()
 	{
 		fntProg = root.render.GetProgram("FontProgram", _FL_);
+		fntDesc = fntProg->GetParam(ShaderType::Vertex, "desc");
+		fntTransform = fntProg->GetParam(ShaderType::Vertex, "transform");
+		fntColor = fntProg->GetParam(ShaderType::Pixel, "color");
+		fntDiffuseMap = fntProg->GetParam(ShaderType::Pixel, "diffuseMap");
 
 		vbuffer = root.render.GetDevice()->CreateBuffer(6 * 1000, sizeof(Fonts::FontVertex), _FL_);
 
@@ -29,6 +29,10 @@ namespace Oak
 		};
 
 		ProgramRef fntProg;
+		Program::Param fntDesc;
+		Program::Param fntTransform;
+		Program::Param fntColor;
+		Program::Param fntDiffuseMap;
 		DataBufferRef vbuffer;
 		VertexDeclRef vdecl;
 		#endif
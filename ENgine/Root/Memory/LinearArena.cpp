@@ -0,0 +1,138 @@
+
+#include "Root/Root.h"
+#include <new>
+
+namespace Oak
+{
+	LinearArena::~LinearArena()
+	{
+		FreeBlocks();
+	}
+
+	LinearArena::Block* LinearArena::AddBlock(size_t size)
+	{
+		uint8_t* ptr = (uint8_t*)root.memory.AllignedAlloc(sizeof(Block) + size, alignof(Block), _FL_);
+
+		Block* block = new(ptr) Block();
+		block->size = size;
+		block->next = current.load(std::memory_order_relaxed);
+
+		current.store(block, std::memory_order_release);
+
+		return block;
+	}
+
+	void LinearArena::FreeBlocks()
+	{
+		Block* block = current.load(std::memory_order_relaxed);
+
+		while (block)
+		{
+			Block* next = block->next;
+
+			block->~Block();
+			root.memory.Free(block);
+
+			block = next;
+		}
+
+		current.store(nullptr, std::memory_order_relaxed);
+	}
+
+	void* LinearArena::Alloc(size_t size, size_t alignment)
+	{
+		while (true)
+		{
+			Block* block = current.load(std::memory_order_acquire);
+
+			if (block)
+			{
+				uintptr_t data = (uintptr_t)(block + 1);
+				size_t used = block->used.load(std::memory_order_relaxed);
+
+				while (true)
+				{
+					size_t from = ((data + used + alignment - 1) & ~(uintptr_t)(alignment - 1)) - data;
+
+					if (from + size > block->size)
+					{
+						break;
+					}
+
+					if (block->used.compare_exchange_weak(used, from + size, std::memory_order_relaxed))
+					{
+						return (void*)(data + from);
+					}
+				}
+			}
+
+			lock.Enter();
+
+			if (current.load(std::memory_order_acquire) == block)
+			{
+				size_t needed = size + alignment;
+				AddBlock(needed > blockSize ? needed : blockSize);
+			}
+
+			lock.UnLock();
+		}
+	}
+
+	void LinearArena::Reset()
+	{
+		Block* block = current.load(std::memory_order_relaxed);
+
+		if (!block)
+		{
+			return;
+		}
+
+		size_t used = GetUsedSize();
+
+		if (used > peakSize)
+		{
+			peakSize = used;
+		}
+
+		if (block->next)
+		{
+			size_t total = 0;
+
+			for (Block* iter = block; iter; iter = iter->next)
+			{
+				total += iter->size;
+			}
+
+			FreeBlocks();
+
+			blockSize = total;
+			AddBlock(blockSize);
+		}
+		else
+		{
+			block->used.store(0, std::memory_order_relaxed);
+		}
+	}
+
+	size_t LinearArena::GetUsedSize()
+	{
+		size_t used = 0;
+
+		for (Block* block = current.load(std::memory_order_acquire); block; block = block->next)
+		{
+			used += block->used.load(std::memory_order_relaxed);
+		}
+
+		return used;
+	}
+
+	size_t LinearArena::GetPeakSize()
+	{
+		return peakSize;
+	}
+
+	void LinearArena::Release()
+	{
+		FreeBlocks();
+	}
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "Support/Defines.h"
+#include "Support/ThreadExecutor.h"
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+
+namespace Oak
+{
+	/**
+	\ingroup gr_code_root_memory
+	*/
+
+	/**
+	\brief LinearArena
+
+	This is a bump allocator. Memory can't be freed per allocation, arena is reset as a whole.
+	When current block is exhausted new block is added. On reset all blocks are merged into one block
+	of a total size, so after warmup arena works with a single block. Allocation is thread safe, reset is not.
+
+	*/
+
+	class CLASS_DECLSPEC LinearArena
+	{
+		#ifndef DOXYGEN_SKIP
+		struct alignas(64) Block
+		{
+			Block* next = nullptr;
+			size_t size = 0;
+			std::atomic<size_t> used{ 0 };
+		};
+
+		std::atomic<Block*> current{ nullptr };
+		size_t blockSize = 256 * 1024;
+		size_t peakSize = 0;
+		CriticalSection lock;
+
+		Block* AddBlock(size_t size);
+		void FreeBlocks();
+		#endif
+
+	public:
+
+		LinearArena() = default;
+		LinearArena(const LinearArena&) = delete;
+		~LinearArena();
+
+		/**
+		\brief Allocate memory from an arena
+
+		\param[in] size Size of memory
+		\param[in] alignment Aligment of an adress
+
+		\return pointer to allocated memory
+		*/
+		void* Alloc(size_t size, size_t alignment = 16);
+
+		/**
+		\brief Make all memory of an arena available again. All previosly allocated memory is invalidated.
+		*/
+		void Reset();
+
+		/**
+		\brief Get size of memory which were allocated since last reset
+
+		\return Size of used memory
+		*/
+		size_t GetUsedSize();
+
+		/**
+		\brief Get maximum size of memory which were allocated between two resets
+
+		\return Size of memory
+		*/
+		size_t GetPeakSize();
+
+		/**
+		\brief Release all memory of an arena
+		*/
+		void Release();
+	};
+}
@@ -1,6 +1,9 @@
 
 #include "Root/Root.h"
 #include <jemalloc/jemalloc.h>
+#include "Root/Files/File.h"
+#include <eastl/sort.h>
+#include "stb_sprintf.h"
 
 void* operator new (size_t size, const char* file, int line)
 {
@@ -14,12 +17,12 @@ void* operator new[](size_t size, const char* file, int line)
 
 void operator delete(void* ptr, const char* file, int line)
 {
-	je_free(ptr);
+	Oak::root.memory.Free(ptr);
 }
 
 void operator delete[](void* ptr, const char* file, int line)
 {
-	je_free(ptr);
+	Oak::root.memory.Free(ptr);
 }
 
 void* operator new(size_t size)
@@ -54,53 +57,206 @@ void operator delete[](void* ptr, size_t)
 
 namespace Oak
 {
-	void* MemoryManager::Alloc(size_t size, const char* file, int line)
+	// State of tracking is stored outside of MemoryManager because global operator new can be called
+	// before constructor of root. All types below are constant initialized.
+
+	struct MemorySpinLock
 	{
-		char8_t* ptr = (char8_t*)je_malloc(size + allocationSize);
+		std::atomic<bool> locked{ false };
+
+		void Enter()
+		{
+			while (locked.exchange(true, std::memory_order_acquire))
+			{
+				while (locked.load(std::memory_order_relaxed))
+				{
+				}
+			}
+		}
 
-		FillAllocation((Allocation*)ptr, size, file, line);
+		void UnLock()
+		{
+			locked.store(false, std::memory_order_release);
+		}
+	};
 
-		return ptr + allocationSize;
+	struct alignas(64) MemoryShard
+	{
+		MemorySpinLock lock;
+		MemoryManager::Allocation* head = nullptr;
+		MemoryManager::Allocation* tail = nullptr;
+	};
+
+	// counters are written on every allocation, so each shard has own copy of them
+	struct CallSiteCounters
+	{
+		std::atomic<int64_t> count{ 0 };
+		std::atomic<int64_t> bytes{ 0 };
+		std::atomic<int64_t> totalCount{ 0 };
+	};
+
+	constexpr static int memoryShardsCount = 16;
+	constexpr static int callSitesCount = 8192;
+
+	static MemoryShard memoryShards[memoryShardsCount];
+	static MemoryManager::CallSite callSites[callSitesCount];
+	static CallSiteCounters callSiteCounters[memoryShardsCount][callSitesCount];
+	static MemorySpinLock callSitesLock;
+	static int usedCallSites[callSitesCount];
+	static std::atomic<int> usedCallSitesCount{ 0 };
+	static std::atomic<int> shardsCounter{ 0 };
+	static thread_local int threadShard = -1;
+
+	static const char untrackedFile[] = "";
+
+	static MemoryManager::CallSite* FindCallSite(const char* file, int line)
+	{
+		if (!file)
+		{
+			file = untrackedFile;
+		}
+
+		uint32_t hash = (uint32_t)(((uintptr_t)file >> 3) ^ ((uint32_t)line * 2654435761u));
+
+		// last entry is reserved for call sites which are not fit in a table
+		for (int i = 0; i < callSitesCount - 1; i++)
+		{
+			int index = (hash + i) % (callSitesCount - 1);
+			MemoryManager::CallSite& site = callSites[index];
+
+			const char* siteFile = site.file.load(std::memory_order_acquire);
+
+			if (siteFile == file && site.line == line)
+			{
+				return &site;
+			}
+
+			if (siteFile == nullptr)
+			{
+				callSitesLock.Enter();
+
+				siteFile = site.file.load(std::memory_order_acquire);
+
+				if (siteFile == nullptr)
+				{
+					site.line = line;
+					site.file.store(file, std::memory_order_release);
+
+					int count = usedCallSitesCount.load(std::memory_order_relaxed);
+					usedCallSites[count] = index;
+					usedCallSitesCount.store(count + 1, std::memory_order_release);
+
+					callSitesLock.UnLock();
+
+					return &site;
+				}
+
+				callSitesLock.UnLock();
+
+				if (siteFile == file && site.line == line)
+				{
+					return &site;
+				}
+			}
+		}
+
+		return &callSites[callSitesCount - 1];
 	}
 
-	void* MemoryManager::AllignedAlloc(size_t size, size_t alignment, const char* file, int line)
+	static int GetThreadShard()
 	{
-		char8_t* ptr = (char8_t*)je_aligned_alloc(alignment, size + allocationSize);
+		if (threadShard == -1)
+		{
+			threadShard = shardsCounter.fetch_add(1, std::memory_order_relaxed) % memoryShardsCount;
+		}
 
-		FillAllocation((Allocation*)ptr, size, file, line);
+		return threadShard;
+	}
 
-		return ptr + allocationSize;
+	static CallSiteCounters& GetCounters(MemoryManager::CallSite* site)
+	{
+		return callSiteCounters[GetThreadShard()][site - callSites];
 	}
 
-	void MemoryManager::FillAllocation(Allocation* allocation, size_t size, const char* file, int line)
+	static void SumCounters(MemoryManager::CallSite& site, int64_t& count, int64_t& bytes, int64_t& totalCount)
 	{
-		allocation->file = file;
-		allocation->line = line;
-		allocation->size = size;
-		allocation->prev = nullptr;
-		allocation->next = nullptr;
+		int index = (int)(&site - callSites);
 
-		if (file)
+		count = 0;
+		bytes = 0;
+		totalCount = 0;
+
+		for (int i = 0; i < memoryShardsCount; i++)
 		{
-			trackedUsedMemory += size;
+			CallSiteCounters& counters = callSiteCounters[i][index];
+
+			count += counters.count.load(std::memory_order_relaxed);
+			bytes += counters.bytes.load(std::memory_order_relaxed);
+			totalCount += counters.totalCount.load(std::memory_order_relaxed);
 		}
-		else
+
+		int64_t peakBytes = site.peakBytes.load(std::memory_order_relaxed);
+
+		while (bytes > peakBytes && !site.peakBytes.compare_exchange_weak(peakBytes, bytes, std::memory_order_relaxed))
 		{
-			untrackedUsedMemory += size;
 		}
+	}
+
+	void* MemoryManager::Alloc(size_t size, const char* file, int line)
+	{
+		uint8_t* ptr = (uint8_t*)je_malloc(size + allocationSize);
+
+		return FillAllocation(ptr, allocationSize, size, file, line);
+	}
+
+	void* MemoryManager::AllignedAlloc(size_t size, size_t alignment, const char* file, int line)
+	{
+		size_t offset = (allocationSize + alignment - 1) & ~(alignment - 1);
 
-		if (head == nullptr)
+		uint8_t* ptr = (uint8_t*)je_aligned_alloc(alignment, size + offset);
+
+		return FillAllocation(ptr, offset, size, file, line);
+	}
+
+	void* MemoryManager::FillAllocation(uint8_t* ptr, size_t offset, size_t size, const char* file, int line)
+	{
+		Allocation* allocation = (Allocation*)(ptr + offset - allocationSize);
+
+		allocation->site = FindCallSite(file, line);
+		allocation->size = size;
+		allocation->offset = offset;
+		allocation->shard = GetThreadShard();
+
+		CallSiteCounters& counters = GetCounters(allocation->site);
+
+		counters.count.fetch_add(1, std::memory_order_relaxed);
+		counters.totalCount.fetch_add(1, std::memory_order_relaxed);
+		counters.bytes.fetch_add(size, std::memory_order_relaxed);
+
+		#ifdef OAK_MEMORY_TRACKING
+		MemoryShard& shard = memoryShards[allocation->shard];
+
+		allocation->next = nullptr;
+
+		shard.lock.Enter();
+
+		allocation->prev = shard.tail;
+
+		if (shard.tail)
 		{
-			head = allocation;
-			tail = allocation;
+			shard.tail->next = allocation;
 		}
 		else
 		{
-			tail->next = allocation;
-			allocation->prev = tail;
-
-			tail = allocation;
+			shard.head = allocation;
 		}
+
+		shard.tail = allocation;
+
+		shard.lock.UnLock();
+		#endif
+
+		return ptr + offset;
 	}
 
 	void MemoryManager::Free(void* p)
@@ -110,66 +266,257 @@ namespace Oak
 			return;
 		}
 
-		uint8_t* ptr = (uint8_t*)p;
-		ptr-= allocationSize;
+		Allocation* allocation = (Allocation*)((uint8_t*)p - allocationSize);
 
-		Allocation* allocation = (Allocation*)ptr;
+		// memory can be freed by other thread, so counters of a shard can go below zero, only sum is valid
+		CallSiteCounters& counters = GetCounters(allocation->site);
 
-		if (allocation->file)
-		{
-			trackedUsedMemory -= allocation->size;
-		}
-		else
-		{
-			untrackedUsedMemory -= allocation->size;
-		}
+		counters.count.fetch_sub(1, std::memory_order_relaxed);
+		counters.bytes.fetch_sub(allocation->size, std::memory_order_relaxed);
+
+		#ifdef OAK_MEMORY_TRACKING
+		MemoryShard& shard = memoryShards[allocation->shard];
+
+		shard.lock.Enter();
 
 		Allocation* prev = allocation->prev;
 		Allocation* next = allocation->next;
 
-		if (prev != nullptr && next != nullptr)
+		if (prev)
 		{
 			prev->next = next;
-			next->prev = prev;
 		}
 		else
-		if (prev != nullptr && next == nullptr)
 		{
-			prev->next = nullptr;
-			tail = prev;
+			shard.head = next;
 		}
-		else
-		if (prev == nullptr && next != nullptr)
+
+		if (next)
 		{
-			next->prev = nullptr;
-			head = next;
+			next->prev = prev;
 		}
 		else
 		{
-			head = nullptr;
-			tail = nullptr;
+			shard.tail = prev;
 		}
 
-		je_free(ptr);
+		shard.lock.UnLock();
+		#endif
+
+		je_free((uint8_t*)p - allocation->offset);
 	}
 
 	void MemoryManager::LogMemory()
 	{
-		Allocation* allocation = head;
+		int64_t trackedUsedMemory = 0;
+		int64_t untrackedUsedMemory = 0;
+
+		for (auto& site : callSites)
+		{
+			const char* file = site.file.load(std::memory_order_acquire);
+
+			int64_t count, bytes, totalCount;
+			SumCounters(site, count, bytes, totalCount);
+
+			if (file && file != untrackedFile)
+			{
+				trackedUsedMemory += bytes;
+			}
+			else
+			{
+				untrackedUsedMemory += bytes;
+			}
+		}
 
 		float trackedMB = (float)trackedUsedMemory / (1024 * 1024);
 		float untrackedMB = (float)untrackedUsedMemory / (1024 * 1024);
 
 		root.Log("Memory", "Total used memory: %4.3f MB (tracked %4.3f MB / untracked %4.3f MB)", (trackedMB + untrackedMB), trackedMB, untrackedMB);
 
-		while (allocation)
+		#ifdef OAK_MEMORY_TRACKING
+		struct AllocationInfo
 		{
-			if (allocation->file)
+			CallSite* site;
+			size_t size;
+		};
+
+		// logging allocates memory, so list of a shard is copied and printed outside of lock
+		for (auto& shard : memoryShards)
+		{
+			shard.lock.Enter();
+
+			int count = 0;
+
+			for (Allocation* allocation = shard.head; allocation; allocation = allocation->next)
 			{
-				root.Log("Memory", "Allocated %i from %s, %i", allocation->size, allocation->file, allocation->line);
+				count++;
 			}
 
-			allocation = allocation->next;
+			AllocationInfo* infos = (AllocationInfo*)je_malloc(sizeof(AllocationInfo) * (count + 1));
+
+			int index = 0;
+
+			for (Allocation* allocation = shard.head; allocation; allocation = allocation->next)
+			{
+				infos[index].site = allocation->site;
+				infos[index].size = allocation->size;
+				index++;
+			}
+
+			shard.lock.UnLock();
+
+			for (int i = 0; i < count; i++)
+			{
+				const char* file = infos[i].site->file.load(std::memory_order_relaxed);
+
+				if (file != untrackedFile)
+				{
+					root.Log("Memory", "Allocated %i from %s, %i", (int)infos[i].size, file, infos[i].site->line);
+				}
+			}
+
+			je_free(infos);
+		}
+		#else
+		for (auto& site : callSites)
+		{
+			const char* file = site.file.load(std::memory_order_acquire);
+
+			int64_t count, bytes, totalCount;
+			SumCounters(site, count, bytes, totalCount);
+
+			if (file && file != untrackedFile && count > 0)
+			{
+				root.Log("Memory", "Allocated %i bytes in %i allocations from %s, %i", (int)bytes, (int)count, file, site.line);
+			}
+		}
+		#endif
+	}
+
+	static void FillStat(MemoryManager::CallSite& site, MemoryManager::CallSiteStat& stat)
+	{
+		stat.file = site.file.load(std::memory_order_acquire);
+		stat.line = site.line;
+		SumCounters(site, stat.count, stat.bytes, stat.totalCount);
+		stat.peakBytes = site.peakBytes.load(std::memory_order_relaxed);
+		stat.frameCount = site.frameCount;
+	}
+
+	void MemoryManager::GetStatistics(eastl::vector<CallSiteStat>& stats)
+	{
+		int count = usedCallSitesCount.load(std::memory_order_acquire);
+
+		stats.resize(count);
+
+		for (int i = 0; i < count; i++)
+		{
+			FillStat(callSites[usedCallSites[i]], stats[i]);
 		}
 	}
-}
\ No newline at end of file
+
+	void MemoryManager::DrawStatistics(int maxLines)
+	{
+		int count = usedCallSitesCount.load(std::memory_order_acquire);
+
+		FrameVector<CallSiteStat> stats;
+		stats.reserve(count);
+
+		for (int i = 0; i < count; i++)
+		{
+			CallSite& site = callSites[usedCallSites[i]];
+
+			if (site.frameCount > 0)
+			{
+				stats.push_back();
+				FillStat(site, stats.back());
+			}
+		}
+
+		eastl::sort(stats.begin(), stats.end(), [](const CallSiteStat& a, const CallSiteStat& b) { return a.frameCount > b.frameCount; });
+
+		int lines = eastl::min(maxLines, (int)stats.size());
+
+		root.render.DebugPrintText(Math::Vector2(5.0f, 5.0f), ScreenCorner::LeftTop, COLOR_WHITE, "Allocations per frame:");
+
+		for (int i = 0; i < lines; i++)
+		{
+			CallSiteStat& stat = stats[i];
+
+			root.render.DebugPrintText(Math::Vector2(5.0f, 20.0f + 15.0f * i), ScreenCorner::LeftTop, COLOR_WHITE, "%i - %s, %i (%4.3f KB alive)",
+										(int)stat.frameCount, stat.file[0] ? stat.file : "untracked", stat.line, (float)stat.bytes / 1024.0f);
+		}
+	}
+
+	bool MemoryManager::DumpStatistics(const char* fileName)
+	{
+		eastl::vector<CallSiteStat> stats;
+		GetStatistics(stats);
+
+		// sorted by call site to make dumps of two builds comparable
+		eastl::sort(stats.begin(), stats.end(), [](const CallSiteStat& a, const CallSiteStat& b)
+		{
+			int res = strcmp(a.file, b.file);
+			return res != 0 ? res < 0 : a.line < b.line;
+		});
+
+		File file;
+
+		if (!file.Open(fileName, File::ModeType::WriteText))
+		{
+			return false;
+		}
+
+		const char* header = "file,line,count,bytes,peak_bytes,total_count,frame_count\n";
+		file.Write(header, (int)strlen(header));
+
+		char line[1024];
+
+		for (auto& stat : stats)
+		{
+			int len = stbsp_snprintf(line, 1024, "\"%s\",%i,%lli,%lli,%lli,%lli,%lli\n", stat.file, stat.line,
+										(long long)stat.count, (long long)stat.bytes, (long long)stat.peakBytes, (long long)stat.totalCount, (long long)stat.frameCount);
+
+			file.Write(line, eastl::min(len, 1023));
+		}
+
+		return true;
+	}
+
+	void* MemoryManager::FrameAlloc(FrameArena arena, size_t size, size_t alignment)
+	{
+		return root.memory.GetFrameArena(arena).Alloc(size, alignment);
+	}
+
+	LinearArena& MemoryManager::GetFrameArena(FrameArena arena)
+	{
+		return (arena == FrameArena::Frame) ? frameArena : renderArenas[renderArena];
+	}
+
+	void MemoryManager::ResetFrame()
+	{
+		int count = usedCallSitesCount.load(std::memory_order_acquire);
+
+		for (int i = 0; i < count; i++)
+		{
+			CallSite& site = callSites[usedCallSites[i]];
+
+			int64_t count, bytes, totalCount;
+			SumCounters(site, count, bytes, totalCount);
+
+			site.frameCount = totalCount - site.frameMark;
+			site.frameMark = totalCount;
+		}
+
+		frameArena.Reset();
+
+		renderArena = 1 - renderArena;
+		renderArenas[renderArena].Reset();
+	}
+
+	void MemoryManager::Release()
+	{
+		frameArena.Release();
+		renderArenas[0].Release();
+		renderArenas[1].Release();
+	}
+}
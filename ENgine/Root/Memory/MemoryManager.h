@@ -1,40 +1,86 @@
-
 #pragma once
 
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+#include <eastl/vector.h>
+#include <eastl/string.h>
+#include "LinearArena.h"
+
+#if defined(OAK_EDITOR) || defined(_DEBUG)
+#define OAK_MEMORY_TRACKING
+#endif
+
 namespace Oak
 {
 	/**
 	\ingroup gr_code_root_memory
 	*/
 
+	enum class FrameArena
+	{
+		Frame /*!< Memory is valid until end of current frame */,
+		Render /*!< Memory is valid until end of next frame, so it can be handed to render stage */
+	};
+
 	/**
-	\brief FileInMemory
+	\ingroup gr_code_root_memory
+	*/
 
-	This a memory manager whihc is keeping track of all allocated memory
+	/**
+	\brief MemoryManager
+
+	This a memory manager whihc is keeping track of all allocated memory. Statistic is collected per call site,
+	i.e. per pair of file and line from which allocation was requested. If OAK_MEMORY_TRACKING is defined (editor
+	and debug builds) every alive allocation is also linked in a list to be able to log leaks. Lists and counters
+	of call sites are sharded between threads, so allocations from different threads are not contending for the
+	same lock or cache line. Counters of shards are summed when statistic is requested.
+	Also manager provides per frame arenas which are reset at the end of every frame.
 
 	*/
 
-	class MemoryManager
+	class CLASS_DECLSPEC MemoryManager
 	{
+	public:
+
 		#ifndef DOXYGEN_SKIP
+		struct CallSite
+		{
+			std::atomic<const char*> file;
+			int line;
+			std::atomic<int64_t> peakBytes;
+			int64_t frameMark;
+			int64_t frameCount;
+		};
+
 		struct Allocation
 		{
-			const char* file = nullptr;
-			int line = 0;
-			size_t size = 0;
-			Allocation* next = nullptr;
-			Allocation* prev = nullptr;
+			CallSite* site;
+			uint64_t size : 40;
+			uint64_t shard : 8;
+			uint64_t offset : 16;
+		#ifdef OAK_MEMORY_TRACKING
+			Allocation* next;
+			Allocation* prev;
+		#endif
 		};
 
 		constexpr static int allocationSize = sizeof(Allocation);
-		Allocation* head = nullptr;
-		Allocation* tail = nullptr;
-
-		size_t trackedUsedMemory = 0;
-		size_t untrackedUsedMemory = 0;
 		#endif
 
-	public:
+		/**
+		\brief Statistic of a call site
+		*/
+		struct CallSiteStat
+		{
+			const char* file = nullptr; /*!< Name of a file. Empty string for allocations without call site */
+			int line = 0; /*!< Number of a line */
+			int64_t count = 0; /*!< Number of alive allocations */
+			int64_t bytes = 0; /*!< Size of alive allocations */
+			int64_t peakBytes = 0; /*!< Maximum size of alive allocations seen at ends of frames and requests of statistic */
+			int64_t totalCount = 0; /*!< Number of allocations since start */
+			int64_t frameCount = 0; /*!< Number of allocations during previous frame */
+		};
 
 		/**
 		\brief Requesst allocation of a memory
@@ -70,11 +116,123 @@ namespace Oak
 		*/
 		void Free(void* ptr);
 
+		/**
+		\brief Requesst allocation of a memory from a frame arena of root memory manager. Such memory shouldn't be deallocated.
+
+		\param[in] arena Type of an arena
+		\param[in] size Size of memory
+		\param[in] alignment Aligment of an adress
+
+		\return pointer to allocated memory
+		*/
+		static void* FrameAlloc(FrameArena arena, size_t size, size_t alignment = 16);
+
+		/**
+		\brief Get arena of current frame
+
+		\param[in] arena Type of an arena
+
+		\return Reference to an arena
+		*/
+		LinearArena& GetFrameArena(FrameArena arena);
+
+		#ifndef DOXYGEN_SKIP
+		void ResetFrame();
+		void Release();
+		#endif
+
 		void LogMemory();
 
+		/**
+		\brief Get statistic of all call sites
+
+		\param[out] stats Array which will be filled by statistic
+		*/
+		void GetStatistics(eastl::vector<CallSiteStat>& stats);
+
+		/**
+		\brief Print statistic of call sites which allocated the most during previous frame via Render::DebugPrintText
+
+		\param[in] maxLines Maximum number of printed call sites
+		*/
+		void DrawStatistics(int maxLines = 20);
+
+		/**
+		\brief Save statistic of all call sites into CSV file
+
+		\param[in] fileName Full path of a file
+
+		\return True will be returned if file was saved
+		*/
+		bool DumpStatistics(const char* fileName);
+
 	private:
 		#ifndef DOXYGEN_SKIP
-		void FillAllocation(Allocation* allocation, size_t size, const char* file, int line);
+		LinearArena frameArena;
+		LinearArena renderArenas[2];
+		int renderArena = 0;
+
+		void* FillAllocation(uint8_t* ptr, size_t offset, size_t size, const char* file, int line);
+		#endif
+	};
+
+	/**
+	\ingroup gr_code_root_memory
+	*/
+
+	/**
+	\brief FrameAllocatorT
+
+	This is EASTL compatible allocator which takes memory from a frame arena. Containers
+	with such allocator should not outlive the arena.
+
+	*/
+
+	template<FrameArena arena>
+	class FrameAllocatorT
+	{
+	public:
+
+		#ifndef DOXYGEN_SKIP
+		FrameAllocatorT(const char* name = nullptr) {}
+		FrameAllocatorT(const FrameAllocatorT& allocator) = default;
+		FrameAllocatorT(const FrameAllocatorT& allocator, const char* name) {}
+		FrameAllocatorT& operator=(const FrameAllocatorT& allocator) = default;
+
+		void* allocate(size_t size, int flags = 0)
+		{
+			return MemoryManager::FrameAlloc(arena, size);
+		}
+
+		void* allocate(size_t size, size_t alignment, size_t offset, int flags = 0)
+		{
+			return MemoryManager::FrameAlloc(arena, size, alignment);
+		}
+
+		void deallocate(void* ptr, size_t size) {}
+
+		const char* get_name() const { return "FrameAllocator"; }
+		void set_name(const char* name) {}
 		#endif
 	};
+
+	#ifndef DOXYGEN_SKIP
+	template<FrameArena arena>
+	inline bool operator==(const FrameAllocatorT<arena>& a, const FrameAllocatorT<arena>& b) { return true; }
+
+	template<FrameArena arena>
+	inline bool operator!=(const FrameAllocatorT<arena>& a, const FrameAllocatorT<arena>& b) { return false; }
+	#endif
+
+	typedef FrameAllocatorT<FrameArena::Frame> FrameAllocator;
+	typedef FrameAllocatorT<FrameArena::Render> RenderFrameAllocator;
+
+	template<typename T>
+	using FrameVector = eastl::vector<T, FrameAllocator>;
+
+	template<typename T>
+	using RenderFrameVector = eastl::vector<T, RenderFrameAllocator>;
+
+	typedef eastl::basic_string<char, FrameAllocator> FrameString;
 }
+
@@ -0,0 +1,140 @@
+
+#include "Root/Root.h"
+
+namespace Oak
+{
+	ObjectPool::ObjectPool(size_t objectSize, size_t objectAlignment)
+	{
+		alignment = objectAlignment < alignof(Slab) ? alignof(Slab) : objectAlignment;
+
+		slotSize = objectSize < sizeof(FreeSlot) ? sizeof(FreeSlot) : objectSize;
+		slotSize = (slotSize + alignment - 1) & ~(alignment - 1);
+
+		headerSize = (sizeof(Slab) + alignment - 1) & ~(alignment - 1);
+	}
+
+	ObjectPool::~ObjectPool()
+	{
+		Release();
+	}
+
+	void ObjectPool::AddSlab(int count)
+	{
+		uint8_t* ptr = (uint8_t*)root.memory.AllignedAlloc(headerSize + slotSize * count, alignment, _FL_);
+
+		Slab* slab = (Slab*)ptr;
+		slab->count = count;
+		slab->next = slabs;
+		slabs = slab;
+
+		// slots are pushed in reverse order, so objects are taken from a fresh slab sequentially
+		uint8_t* slots = ptr + headerSize;
+
+		for (int i = count - 1; i >= 0; i--)
+		{
+			FreeSlot* slot = (FreeSlot*)(slots + slotSize * i);
+			slot->next = freeSlots;
+			freeSlots = slot;
+		}
+
+		capacity += count;
+		freeCount += count;
+	}
+
+	void* ObjectPool::Alloc()
+	{
+		lock.Enter();
+
+		if (!freeSlots)
+		{
+			AddSlab(slabCapacity);
+
+			if (slabCapacity < 1024)
+			{
+				slabCapacity *= 2;
+			}
+		}
+
+		FreeSlot* slot = freeSlots;
+		freeSlots = slot->next;
+		freeCount--;
+
+		usedCount++;
+
+		if (usedCount > peakCount)
+		{
+			peakCount = usedCount;
+		}
+
+		lock.UnLock();
+
+		return slot;
+	}
+
+	void ObjectPool::Free(void* ptr)
+	{
+		if (!ptr)
+		{
+			return;
+		}
+
+		lock.Enter();
+
+		FreeSlot* slot = (FreeSlot*)ptr;
+		slot->next = freeSlots;
+		freeSlots = slot;
+
+		freeCount++;
+		usedCount--;
+
+		lock.UnLock();
+	}
+
+	void ObjectPool::Reserve(int count)
+	{
+		lock.Enter();
+
+		if (freeCount < count)
+		{
+			AddSlab(count - freeCount);
+		}
+
+		lock.UnLock();
+	}
+
+	int ObjectPool::GetCapacity()
+	{
+		return capacity;
+	}
+
+	int ObjectPool::GetUsedCount()
+	{
+		return usedCount;
+	}
+
+	int ObjectPool::GetPeakCount()
+	{
+		return peakCount;
+	}
+
+	void ObjectPool::Release()
+	{
+		lock.Enter();
+
+		if (usedCount == 0)
+		{
+			while (slabs)
+			{
+				Slab* next = slabs->next;
+				root.memory.Free(slabs);
+				slabs = next;
+			}
+
+			freeSlots = nullptr;
+			capacity = 0;
+			freeCount = 0;
+		}
+
+		lock.UnLock();
+	}
+}
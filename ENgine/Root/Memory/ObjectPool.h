@@ -0,0 +1,113 @@
+#pragma once
+
+#include "Support/Defines.h"
+#include "Support/ThreadExecutor.h"
+#include <stdint.h>
+#include <stddef.h>
+
+namespace Oak
+{
+	/**
+	\ingroup gr_code_root_memory
+	*/
+
+	/**
+	\brief ObjectPool
+
+	This is a pool of fixed size objects. Memory is taken in slabs, freed objects are put into a free list
+	and reused by next allocations. Slabs are never compacted, so pointers to alive objects are stable.
+
+	*/
+
+	class CLASS_DECLSPEC ObjectPool
+	{
+		#ifndef DOXYGEN_SKIP
+		struct Slab
+		{
+			Slab* next;
+			int count;
+		};
+
+		struct FreeSlot
+		{
+			FreeSlot* next;
+		};
+
+		size_t slotSize;
+		size_t alignment;
+		size_t headerSize;
+		int slabCapacity = 32;
+
+		Slab* slabs = nullptr;
+		FreeSlot* freeSlots = nullptr;
+
+		int capacity = 0;
+		int freeCount = 0;
+		int usedCount = 0;
+		int peakCount = 0;
+
+		CriticalSection lock;
+
+		void AddSlab(int count);
+		#endif
+
+	public:
+
+		/**
+		\brief Constructor
+
+		\param[in] objectSize Size of an object
+		\param[in] objectAlignment Aligment of an object
+		*/
+		ObjectPool(size_t objectSize, size_t objectAlignment);
+		ObjectPool(const ObjectPool&) = delete;
+		~ObjectPool();
+
+		/**
+		\brief Take memory for one object from a pool
+
+		\return pointer to memory
+		*/
+		void* Alloc();
+
+		/**
+		\brief Return memory of an object to a pool
+
+		\param[in] ptr Pointer to memory previosly returned by Alloc
+		*/
+		void Free(void* ptr);
+
+		/**
+		\brief Make sure that requested number of objects can be allocated without adding a slab
+
+		\param[in] count Number of objects
+		*/
+		void Reserve(int count);
+
+		/**
+		\brief Get number of objects which can be stored in a pool without adding a slab
+
+		\return Capacity of a pool
+		*/
+		int GetCapacity();
+
+		/**
+		\brief Get number of alive objects
+
+		\return Number of objects
+		*/
+		int GetUsedCount();
+
+		/**
+		\brief Get maximum number of objects which were alive at the same time
+
+		\return Number of objects
+		*/
+		int GetPeakCount();
+
+		/**
+		\brief Release all slabs. Slabs are kept if a pool still has alive objects.
+		*/
+		void Release();
+	};
+}
@@ -6,6 +6,8 @@ namespace Oak
 	
 	CLASSREGEX(Program, TriangleProgram, MeshPrograms::TriangleProgram, "TriangleProgram")
 	CLASSREGEX_END(Program, TriangleProgram)
+	CLASSREGEX(Program, TriangleInstProgram, MeshPrograms::TriangleInstProgram, "TriangleInstProgram")
+	CLASSREGEX_END(Program, TriangleInstProgram)
 	CLASSREGEX(Program, ShTriangleProgram, MeshPrograms::ShTriangleProgram, "ShTriangleProgram")
 	CLASSREGEX_END(Program, ShTriangleProgram)
 	/*CLASSREGEX(Program, ColorProgram, MeshPrograms::ColorProgram, "ColorProgram")
@@ -19,7 +21,7 @@ namespace Oak
 	CLASSREGEX(Program, QuadProgramNoDepth, MeshPrograms::QuadProgramNoDepth, "QuadProgramNoDepth")
 	CLASSREGEX_END(Program, QuadProgramNoDepth)*/
 
-	Program* MeshPrograms::GetTranglPrg()
+	MeshPrograms::MeshProgram* MeshPrograms::GetTranglPrg()
 	{
 		static ProgramRef prg;
 
@@ -28,10 +30,10 @@ namespace Oak
 			prg = root.render.GetProgram("TriangleProgram", _FL_);
 		}
 
-		return prg;
+		return (MeshProgram*)prg.Get();
 	}
 
-	Program* MeshPrograms::GetShdTranglPrg()
+	MeshPrograms::MeshProgram* MeshPrograms::GetShdTranglPrg()
 	{
 		static ProgramRef prg;
 
@@ -40,6 +42,24 @@ namespace Oak
 			prg = root.render.GetProgram("ShTriangleProgram", _FL_);
 		}
 
-		return prg;
+		return (MeshProgram*)prg.Get();
+	}
+
+	MeshPrograms::MeshProgram* MeshPrograms::GetInstancedPrg(MeshProgram* prg)
+	{
+		static ProgramRef instPrg;
+
+		if (prg != GetTranglPrg())
+		{
+			return nullptr;
+		}
+
+		if (!instPrg.Get())
+		{
+			instPrg = root.render.GetProgram("TriangleInstProgram", _FL_);
+		}
+
+		// shaders are compiled from triangle_inst.shader if binaries are missing, if it fails every instance is drawn separately
+		return instPrg->IsLoaded() ? (MeshProgram*)instPrg.Get() : nullptr;
 	}
 }
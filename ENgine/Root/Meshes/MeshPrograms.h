@@ -30,23 +30,68 @@ namespace Oak
 			};
 		};
 
-		class TriangleProgram : public Program
+		class MeshProgram : public Program
+		{
+		public:
+			Param trans;
+			Param viewProj;
+			Param color;
+			Param diffuseMap;
+
+			virtual bool Init()
+			{
+				Program::Init();
+
+				trans = GetParam(ShaderType::Vertex, "trans");
+				viewProj = GetParam(ShaderType::Vertex, "view_proj");
+				color = GetParam(ShaderType::Pixel, "color");
+				diffuseMap = GetParam(ShaderType::Pixel, "diffuseMap");
+
+				return true;
+			};
+		};
+
+		class TriangleProgram : public MeshProgram
 		{
 		public:
 			virtual const char* GetVsName() { return "triangle_vs.shd"; };
 			virtual const char* GetPsName() { return "triangle_ps.shd"; };
 		};
 
-		class ShTriangleProgram : public Program
+		class TriangleInstProgram : public MeshProgram
 		{
 		public:
+			virtual const char* GetVsName() { return "triangle_inst_vs.shd"; };
+			virtual const char* GetPsName() { return "triangle_inst_ps.shd"; };
+		};
+
+		class ShTriangleProgram : public MeshProgram
+		{
+		public:
+			int shTransGlobal = -1;
+			int shdMapGlobal = -1;
+			Param shTrans;
+			Param shdMap;
+
 			virtual const char* GetVsName() { return "sh_triangle_vs.shd"; };
 			virtual const char* GetPsName() { return "sh_triangle_ps.shd"; };
 
+			virtual bool Init()
+			{
+				MeshProgram::Init();
+
+				shTransGlobal = GetGlobalParam("sh_trans");
+				shdMapGlobal = GetGlobalParam("shdMap");
+				shTrans = GetParam(ShaderType::Vertex, "sh_trans");
+				shdMap = GetParam(ShaderType::Pixel, "shdMap");
+
+				return true;
+			};
+
 			virtual void ApplyStates()
 			{
-				SetMatrix(ShaderType::Vertex, "sh_trans", &(matrixes["sh_trans"]), 1);
-				SetTexture(ShaderType::Pixel, "shdMap", textures["shdMap"]);
+				SetMatrix(shTrans, &GetMatrix(shTransGlobal), 1);
+				SetTexture(shdMap, GetTexture(shdMapGlobal));
 			};
 		};
 
@@ -86,7 +131,8 @@ namespace Oak
 			};
 		};
 
-		static CLASS_DECLSPEC Program* GetTranglPrg();
-		static CLASS_DECLSPEC Program* GetShdTranglPrg();
+		static CLASS_DECLSPEC MeshProgram* GetTranglPrg();
+		static CLASS_DECLSPEC MeshProgram* GetShdTranglPrg();
+		static CLASS_DECLSPEC MeshProgram* GetInstancedPrg(MeshProgram* prg);
 	};
 }
\ No newline at end of file
@@ -53,27 +53,45 @@ namespace Oak
 		Render(MeshPrograms::GetShdTranglPrg());
 	}
 
-	void Mesh::Instance::Render(Program* prg)
+	void Mesh::Instance::Render(Program* program)
 	{
-		if (!visible)
+		// only programs from MeshPrograms are passed here
+		auto* prg = (MeshPrograms::MeshProgram*)program;
+
+		if (!visible || (cullingEntry && !cullingEntry->IsVisible()))
+		{
+			return;
+		}
+
+		// instances with per submesh transforms can't share a draw call
+		MeshPrograms::MeshProgram* instPrg = transforms.size() == 0 ? MeshPrograms::GetInstancedPrg(prg) : nullptr;
+
+		if (instPrg)
 		{
+			RenderInstanced(instPrg);
 			return;
 		}
 
 		Math::Matrix trans;
 		root.render.GetTransform(TransformStage::WrldViewProj, trans);
 
-		root.render.GetDevice()->SetProgram(prg);
+		Math::Matrix view;
+		root.render.GetTransform(TransformStage::View, view);
+
+		CommandBuffer* commands = root.render.GetCommandBuffer();
+
+		commands->SetProgram(prg);
+		commands->SetDepth(view.MulVertex(transform.Pos()).z);
 
 		if (transforms.size() == 0)
 		{
-			prg->SetMatrix(ShaderType::Vertex, "trans", &transform, 1);
+			commands->SetMatrix(prg->trans, &transform, 1);
 		}
 
-		prg->SetMatrix(ShaderType::Vertex, "view_proj", &trans, 1);
-		prg->SetVector(ShaderType::Pixel, "color", (Math::Vector4*)&color, 1);
+		commands->SetMatrix(prg->viewProj, &trans, 1);
+		commands->SetVector(prg->color, (Math::Vector4*)&color, 1);
 
-		root.render.GetDevice()->SetVertexDecl(res->vdecl);
+		commands->SetVertexDecl(res->vdecl);
 
 		for (int i = 0; i < res->meshes.size(); i++)
 		{
@@ -84,16 +102,53 @@ namespace Oak
 				continue;
 			}
 
-			root.render.GetDevice()->SetVertexBuffer(0, mesh.vertices);
-			root.render.GetDevice()->SetIndexBuffer(mesh.indices);
+			commands->SetVertexBuffer(mesh.vertices);
+			commands->SetIndexBuffer(mesh.indices);
 
 			if (transforms.size() > 0)
 			{
-				prg->SetMatrix(ShaderType::Vertex, "trans", &transforms[i], 1);
+				commands->SetMatrix(prg->trans, &transforms[i], 1);
+			}
+
+			commands->SetTexture(prg->diffuseMap, mesh.texture != -1 ? res->textures[mesh.texture] : nullptr);
+			commands->DrawIndexed(PrimitiveTopology::TrianglesList, 0, 0, mesh.num_triangles);
+		}
+	}
+
+	void Mesh::Instance::RenderInstanced(Program* program)
+	{
+		auto* prg = (MeshPrograms::MeshProgram*)program;
+
+		Math::Matrix trans;
+		root.render.GetTransform(TransformStage::WrldViewProj, trans);
+
+		Math::Matrix view;
+		root.render.GetTransform(TransformStage::View, view);
+
+		CommandBuffer* commands = root.render.GetCommandBuffer();
+
+		commands->SetProgram(prg);
+		commands->SetDepth(view.MulVertex(transform.Pos()).z);
+		commands->SetMatrix(prg->viewProj, &trans, 1);
+		commands->SetVertexDecl(res->instVdecl);
+
+		MeshInstanceData instance;
+		instance.transform = transform;
+		instance.color = color;
+
+		for (int i = 0; i < res->meshes.size(); i++)
+		{
+			SubMesh &mesh = res->meshes[i];
+
+			if (!mesh.indices)
+			{
+				continue;
 			}
 
-			prg->SetTexture(ShaderType::Pixel, "diffuseMap", mesh.texture != -1 ? res->textures[mesh.texture] : nullptr);
-			root.render.GetDevice()->DrawIndexed(PrimitiveTopology::TrianglesList, 0, 0, mesh.num_triangles);
+			commands->SetVertexBuffer(mesh.vertices);
+			commands->SetIndexBuffer(mesh.indices);
+			commands->SetTexture(prg->diffuseMap, mesh.texture != -1 ? res->textures[mesh.texture] : nullptr);
+			commands->DrawIndexedInstance(PrimitiveTopology::TrianglesList, 0, 0, mesh.num_triangles, &instance, sizeof(instance));
 		}
 	}
 
@@ -126,6 +181,13 @@ namespace Oak
 		VertexDecl::ElemDesc desc[] = { { ElementType::Float3, ElementSemantic::Position, 0 },{ ElementType::Float2, ElementSemantic::Texcoord, 0 },{ ElementType::Float3, ElementSemantic::Texcoord, 1 } };
 		vdecl = root.render.GetDevice()->CreateVertexDecl(3, desc, _FL_);
 
+		// rows of a transform and a color are fetched per instance
+		VertexDecl::ElemDesc instDesc[] = { { ElementType::Float3, ElementSemantic::Position, 0 },{ ElementType::Float2, ElementSemantic::Texcoord, 0 },{ ElementType::Float3, ElementSemantic::Texcoord, 1 },
+			{ ElementType::Float4, ElementSemantic::Texcoord, 2, true },{ ElementType::Float4, ElementSemantic::Texcoord, 3, true },
+			{ ElementType::Float4, ElementSemantic::Texcoord, 4, true },{ ElementType::Float4, ElementSemantic::Texcoord, 5, true },
+			{ ElementType::Float4, ElementSemantic::Color, 0, true } };
+		instVdecl = root.render.GetDevice()->CreateVertexDecl(8, instDesc, _FL_);
+
 		return LoadFBX(filename);
 	}
 
@@ -3,6 +3,7 @@
 
 #include "Root/Render/Render.h"
 #include "Root/TaskExecutor/TaskExecutor.h"
+#include "Root/Scenes/SpatialIndex.h"
 
 namespace Oak
 {
@@ -21,6 +22,7 @@ namespace Oak
 			eastl::vector<Math::Matrix> transforms;
 			Color color;
 			int visible = 1;
+			const SpatialIndex::Entry* cullingEntry = nullptr;
 
 			void Init(Mesh* mesh, TaskExecutor::SingleTaskPool* taskPool);
 
@@ -35,6 +37,7 @@ namespace Oak
 			void Render(float dt);
 			void ShRender(float dt);
 			void Render(Program* prg);
+			void RenderInstanced(Program* prg);
 
 			void GetLocatorTransform(const char* name, Math::Matrix& loc_transform);
 
@@ -48,6 +51,12 @@ namespace Oak
 			Math::Vector3 normal;
 		};
 
+		struct CLASS_DECLSPEC MeshInstanceData
+		{
+			Math::Matrix transform;
+			Color color;
+		};
+
 		struct CLASS_DECLSPEC SubMesh
 		{
 			int texture = -1;
@@ -60,6 +69,7 @@ namespace Oak
 		};
 
 		VertexDeclRef vdecl;
+		VertexDeclRef instVdecl;
 
 		Math::Vector3 bb_max = -FLT_MAX;
 		Math::Vector3 bb_min = FLT_MAX;
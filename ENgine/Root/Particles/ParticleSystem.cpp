@@ -7,7 +7,6 @@ namespace Oak
 	{
 		res = set_res;
 		taskPool = set_taskPool;
-		taskPool->AddTask(0, this, (Object::Delegate)&ParticleSystem::Update);
 
 		renderPool = set_renderPool;
 		renderPool->AddTask(100, this, (Object::Delegate)&ParticleSystem::Render);
@@ -16,6 +15,8 @@ namespace Oak
 
 		system = SPK::SPKObject::copy(set_res);
 		system->initialize();
+
+		root.particles.AddToUpdate(this);
 	}
 
 	void ParticleSystem::SetTransform(Math::Matrix& transform)
@@ -92,20 +93,20 @@ namespace Oak
 
 	void ParticleSystem::Update(float dt)
 	{
-		if (simulating && visible)
+		if (!idle && simulating && visible)
 		{
 			system->updateParticles(dt);
 		}
+	}
 
-		if (autoDelete && !system->isActive())
-		{
-			Release();
-		}
+	bool ParticleSystem::IsFinished()
+	{
+		return !idle && autoDelete && !system->isActive();
 	}
 
 	void ParticleSystem::Render(float dt)
 	{
-		if (visible)
+		if (!idle && visible)
 		{
 			system->renderParticles();
 		}
@@ -113,10 +114,17 @@ namespace Oak
 
 	void ParticleSystem::Release()
 	{
-		taskPool->DelAllTasks(this);
-		renderPool->DelAllTasks(this);
+		// pooled instance stays in update and render lists until its task pool is released
+		if (pool)
+		{
+			idle = true;
+			pool->push_back(this);
 
-		root.particles.DecRef(res);
+			return;
+		}
+
+		root.particles.RemoveFromUpdate(this);
+		renderPool->DelAllTasks(this);
 
 		delete this;
 	}
@@ -10,6 +10,8 @@ namespace Oak
 {
 	class CLASS_DECLSPEC ParticleSystem : public Object
 	{
+		friend class Particles;
+
 		SPK::Ref<SPK::System> res;
 		SPK::Ref<SPK::System> system;
 
@@ -23,6 +25,12 @@ namespace Oak
 		TaskExecutor::SingleTaskPool* taskPool;
 		TaskExecutor::SingleTaskPool* renderPool;
 
+		int updateIndex = -1;
+
+		// instance of a fire-and-forget effect goes back into a pool of an effect instead of deletion
+		eastl::vector<ParticleSystem*>* pool = nullptr;
+		bool idle = false;
+
 	public:
 
 		void Init(SPK::Ref<SPK::System> res, TaskExecutor::SingleTaskPool* taskPool, TaskExecutor::SingleTaskPool* renderPool, bool autoDelete);
@@ -46,6 +54,7 @@ namespace Oak
 		void Restart();
 
 		void Update(float dt);
+		bool IsFinished();
 		void Render(float dt);
 
 		void Release();
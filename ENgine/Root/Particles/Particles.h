@@ -1,26 +1,134 @@
-
 #pragma once
 
 #include "Root/Root.h"
 #include "Spark.h"
 #include "ParticleSystem.h"
+#include "Support/ThreadExecutor.h"
+#include <atomic>
 
 namespace Oak
 {
+	/**
+	\ingroup gr_code_root_particles
+	*/
+
+	/**
+	\brief Particles
+
+	This manager keeps library of particle effects. Effect is loaded from a file Spark/<name>.spk,
+	which is a compiled binary copy of Spark/<name>.xml. Editor always loads XML and compiles binary.
+	Loaded effect is kept as a template and instances of an effect are copies of this template.
+	Effects can be preloaded on a loading thread, render resources of an effect are created
+	on a main thread when first instance is created. Instances of fire-and-forget effects are
+	pooled per effect, finished instance is kept with its buffers and restarted on next spawn.
+
+	*/
+
 	class CLASS_DECLSPEC Particles
 	{
-		struct ParticleRef
+		enum class EffectState
+		{
+			Queued,
+			Loading,
+			Loaded,
+			Ready
+		};
+
+		struct Effect
 		{
-			int count;
+			std::string name;
 			SPK::Ref<SPK::System> system;
+			std::atomic<EffectState> state{ EffectState::Queued };
+			eastl::vector<ParticleSystem*> instances;
+			eastl::vector<ParticleSystem*> freeInstances;
+		};
+
+		// systems of one task pool are updated by one task in parallel chunks on worker threads
+		class UpdateStage : public Object
+		{
+		public:
+
+			struct UpdateJob : TaskExecutor::ParallelJob
+			{
+				UpdateStage* stage = nullptr;
+				float dt = 0.0f;
+
+				void Execute(int from, int to) override;
+			};
+
+			TaskExecutor::SingleTaskPool* taskPool = nullptr;
+			eastl::vector<ParticleSystem*> systems;
+			bool updating = false;
+
+			void Update(float dt);
 		};
 
-		std::map<std::string, ParticleRef> particles;
+		class Loader : public ThreadCaller
+		{
+		public:
+			Particles* owner = nullptr;
+
+			void Work();
+		};
+
+		std::map<std::string, Effect, std::less<>> effects;
+		eastl::vector<UpdateStage*> stages;
+
+		Loader loader;
+		ThreadExecutor loadThread;
+		ThreadSemaphore loadSignal;
+		CriticalSection loadLock;
+		std::atomic<bool> loading{ false };
+		eastl::vector<Effect*> loadQueue;
+
+		void DeleteStage(UpdateStage* stage);
+
+		Effect& GetEffect(const char* name);
+		Effect* GetReadyEffect(const char* name);
+		void Load();
+		static SPK::Ref<SPK::System> LoadSystem(const char* name);
+		static void LoadResources(Effect& effect);
 
 	public:
 
+	#ifndef DOXYGEN_SKIP
 		void Init();
+		void Release();
+	#endif
+
+		/**
+		\brief Start loading of an effect on a loading thread. Call does nothing if effect was already requested.
+
+		\param[in] name Name of an effect
+		*/
+		void Preload(const char* name);
+
+		/**
+		\brief Create an instance of an effect. If effect is still loading a call waits for it.
+
+		\param[in] name Name of an effect
+		\param[in] taskPool Task pool in which instance will be updated
+		\param[in] renderPool Task pool in which instance will be rendered
+		\param[in] autoDelete Instance will be released after all particles died
+
+		\return Pointer to an instance. nullptr will be returned if effect wasn't loaded.
+		*/
 		ParticleSystem* LoadParticle(const char* name, TaskExecutor::SingleTaskPool* taskPool, TaskExecutor::SingleTaskPool* renderPool, bool autoDelete);
-		bool DecRef(SPK::Ref<SPK::System> system);
+
+		/**
+		\brief Play an effect once. Instance is taken from a pool of an effect, so after warm up a call doesn't allocate.
+
+		\param[in] name Name of an effect
+		\param[in] taskPool Task pool in which instance will be updated
+		\param[in] renderPool Task pool in which instance will be rendered
+		\param[in] transform Transform of an instance
+		*/
+		void Spawn(const char* name, TaskExecutor::SingleTaskPool* taskPool, TaskExecutor::SingleTaskPool* renderPool, Math::Matrix& transform);
+
+		#ifndef DOXYGEN_SKIP
+		void AddToUpdate(ParticleSystem* system);
+		void RemoveFromUpdate(ParticleSystem* system);
+		void ReleaseInstances(TaskExecutor::SingleTaskPool* taskPool);
+		#endif
 	};
 }
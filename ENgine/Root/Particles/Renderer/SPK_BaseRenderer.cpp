@@ -48,8 +48,27 @@ namespace SPK
 
 		default :
 			SPK_LOG_WARNING("GLRenderer::setBlendMode(BlendMode) - Unsupported blending mode. Nothing happens");
-			break;
+			return;
 		}
+
+		this->blendMode = blendMode;
+	}
+
+	void GLRenderer::innerImport(const IO::Descriptor& descriptor)
+	{
+		Renderer::innerImport(descriptor);
+
+		const IO::Attribute* attrib = NULL;
+
+		if ((attrib = descriptor.getAttributeWithValue("blend mode")))
+			setBlendMode(static_cast<BlendMode>(attrib->getValue<int32>()));
+	}
+
+	void GLRenderer::innerExport(IO::Descriptor& descriptor) const
+	{
+		Renderer::innerExport(descriptor);
+
+		descriptor.getAttribute("blend mode")->setValue(static_cast<int32>(getBlendMode()));
 	}
 
 	void GLRenderer::saveGLStates()
@@ -31,6 +31,11 @@ namespace SPK
 	*/
 	class GLRenderer : public Renderer
 	{
+	SPK_START_DESCRIPTION
+	SPK_PARENT_ATTRIBUTES(Renderer)
+	SPK_ATTRIBUTE("blend mode",ATTRIBUTE_TYPE_INT32)
+	SPK_END_DESCRIPTION
+
 	public :
 
 		////////////////
@@ -71,6 +76,12 @@ namespace SPK
 		*/
 		bool isBlendingEnabled() const;
 
+		/**
+		* @brief Gets the blend mode of this GLRenderer
+		* @return the blend mode of this GLRenderer
+		*/
+		BlendMode getBlendMode() const;
+
 		/**
 		* @brief Gets the source blending function of this GLRenderer
 		* @return the source blending function of this GLRenderer
@@ -105,15 +116,13 @@ namespace SPK
 		*/
 		static void restoreGLStates();
 
-	public :
-        /*spark_description(GLRenderer, Renderer)
-		(
-        );*/
-
 	protected :
 
 		GLRenderer(bool NEEDS_DATASET);
 
+		virtual void innerImport(const IO::Descriptor& descriptor) override;
+		virtual void innerExport(IO::Descriptor& descriptor) const override;
+
 		/** @brief Inits the blending of this GLRenderer */
 		void initBlending() const;
 
@@ -122,6 +131,7 @@ namespace SPK
 
 	private :
 
+		BlendMode blendMode;
 		bool blendingEnabled;
 		int srcBlending;
 		int destBlending;
@@ -129,6 +139,7 @@ namespace SPK
 
 	inline GLRenderer::GLRenderer(bool NEEDS_DATASET) :
 		Renderer(NEEDS_DATASET),
+		blendMode(BLEND_MODE_NONE),
 		blendingEnabled(false)
 		//srcBlending(GL_SRC_ALPHA),
 		//destBlending(GL_ONE_MINUS_SRC_ALPHA)
@@ -150,6 +161,11 @@ namespace SPK
 		return blendingEnabled;
 	}
 
+	inline BlendMode GLRenderer::getBlendMode() const
+	{
+		return blendMode;
+	}
+
 	inline int GLRenderer::getSrcBlendingFunction() const
 	{
 		return srcBlending;
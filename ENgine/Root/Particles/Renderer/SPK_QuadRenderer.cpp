@@ -45,20 +45,40 @@ namespace SPK
 		Oriented3DRenderBehavior(),
 		textureIndex(0)
 	{
-		VertexDecl::ElemDesc desc[] = { { ElementType::Float3, ElementSemantic::Position, 0 },{ ElementType::Float2, ElementSemantic::Texcoord, 0 },{ ElementType::Ubyte4, ElementSemantic::Color, 0 } };
-		vdecl = root.render.GetDevice()->CreateVertexDecl(3, desc, _FL_);
-		prg = root.render.GetProgram("ParticleProgram", _FL_);
 	}
 
+	// copy shares render objects of a source instead of creating them again
 	GLQuadRenderer::GLQuadRenderer(const GLQuadRenderer& renderer) :
 		GLRenderer(renderer),
 		QuadRenderBehavior(renderer),
 		Oriented3DRenderBehavior(renderer),
+		prg(renderer.prg),
+		viewProjParam(renderer.viewProjParam),
+		transParam(renderer.transParam),
+		diffuseMapParam(renderer.diffuseMapParam),
+		vdecl(renderer.vdecl),
+		texture(renderer.texture),
+		texturePath(renderer.texturePath),
 		textureIndex(renderer.textureIndex)
 	{
-		VertexDecl::ElemDesc desc[] = { { ElementType::Float3, ElementSemantic::Position, 0 },{ ElementType::Float2, ElementSemantic::Texcoord, 0 },{ ElementType::Ubyte4, ElementSemantic::Color, 0 } };
-		vdecl = root.render.GetDevice()->CreateVertexDecl(3, desc, _FL_);
-		prg = root.render.GetProgram("ParticleProgram", _FL_);
+	}
+
+	void GLQuadRenderer::loadResources()
+	{
+		if (!prg)
+		{
+			VertexDecl::ElemDesc desc[] = { { ElementType::Float3, ElementSemantic::Position, 0 },{ ElementType::Float2, ElementSemantic::Texcoord, 0 },{ ElementType::Ubyte4, ElementSemantic::Color, 0 } };
+			vdecl = root.render.GetDevice()->CreateVertexDecl(3, desc, _FL_);
+			prg = root.render.GetProgram("ParticleProgram", _FL_);
+			viewProjParam = prg->GetParam(ShaderType::Vertex, "view_proj");
+			transParam = prg->GetParam(ShaderType::Vertex, "trans");
+			diffuseMapParam = prg->GetParam(ShaderType::Pixel, "diffuseMap");
+		}
+
+		if (!texture && !texturePath.empty())
+		{
+			texture = root.render.LoadTexture(texturePath.c_str(), _FL_);
+		}
 	}
 
 	bool GLQuadRenderer::setTexturingMode(TextureMode mode)
@@ -70,6 +90,72 @@ namespace SPK
 		return true;
 	}
 
+	void GLQuadRenderer::innerImport(const IO::Descriptor& descriptor)
+	{
+		GLRenderer::innerImport(descriptor);
+
+		const IO::Attribute* attrib = NULL;
+
+		if ((attrib = descriptor.getAttributeWithValue("texture")))
+			setTexture(attrib->getValue<std::string>());
+
+		if ((attrib = descriptor.getAttributeWithValue("texturing mode")))
+			setTexturingMode(static_cast<TextureMode>(attrib->getValue<int32>()));
+
+		if ((attrib = descriptor.getAttributeWithValue("atlas dimensions")))
+		{
+			std::vector<uint32> tmpDimensions = attrib->getValues<uint32>();
+			if (tmpDimensions.size() == 2)
+				setAtlasDimensions(tmpDimensions[0],tmpDimensions[1]);
+			else
+				SPK_LOG_ERROR("GLQuadRenderer::innerImport(const IO::Descriptor&) - Wrong number of atlas dimensions : " << tmpDimensions.size());
+		}
+
+		if ((attrib = descriptor.getAttributeWithValue("scale")))
+		{
+			std::vector<float> tmpScales = attrib->getValues<float>();
+			if (tmpScales.size() == 2)
+				setScale(tmpScales[0],tmpScales[1]);
+			else
+				SPK_LOG_ERROR("GLQuadRenderer::innerImport(const IO::Descriptor&) - Wrong number of scales : " << tmpScales.size());
+		}
+
+		if ((attrib = descriptor.getAttributeWithValue("orientation")))
+		{
+			std::vector<int32> tmpOrientation = attrib->getValues<int32>();
+			if (tmpOrientation.size() == 3)
+				setOrientation(static_cast<LookOrientation>(tmpOrientation[0]),static_cast<UpOrientation>(tmpOrientation[1]),static_cast<LockedAxis>(tmpOrientation[2]));
+			else
+				SPK_LOG_ERROR("GLQuadRenderer::innerImport(const IO::Descriptor&) - Wrong number of orientation values : " << tmpOrientation.size());
+		}
+
+		if ((attrib = descriptor.getAttributeWithValue("look vector")))
+			lookVector = attrib->getValue<Vector3D>();
+
+		if ((attrib = descriptor.getAttributeWithValue("up vector")))
+			upVector = attrib->getValue<Vector3D>();
+	}
+
+	void GLQuadRenderer::innerExport(IO::Descriptor& descriptor) const
+	{
+		GLRenderer::innerExport(descriptor);
+
+		descriptor.getAttribute("texture")->setValueOptionalOnEmpty(texturePath);
+		descriptor.getAttribute("texturing mode")->setValue(static_cast<int32>(getTexturingMode()));
+
+		uint32 tmpDimensions[2] = {static_cast<uint32>(getAtlasDimensionX()),static_cast<uint32>(getAtlasDimensionY())};
+		descriptor.getAttribute("atlas dimensions")->setValues(tmpDimensions,2);
+
+		float tmpScales[2] = {getScaleX(),getScaleY()};
+		descriptor.getAttribute("scale")->setValues(tmpScales,2);
+
+		int32 tmpOrientation[3] = {static_cast<int32>(getLookOrientation()),static_cast<int32>(getUpOrientation()),static_cast<int32>(getLockedAxis())};
+		descriptor.getAttribute("orientation")->setValues(tmpOrientation,3);
+
+		descriptor.getAttribute("look vector")->setValue(lookVector);
+		descriptor.getAttribute("up vector")->setValue(upVector);
+	}
+
 	RenderBuffer* GLQuadRenderer::attachRenderBuffer(const Group& group) const
 	{
 		return SPK_NEW(GLBuffer,group.getCapacity() << 2);
@@ -78,6 +164,10 @@ namespace SPK
 	void GLQuadRenderer::render(const Group& group,const DataSet* dataSet,RenderBuffer* renderBuffer) const
 	{
 		SPK_ASSERT(renderBuffer != NULL,"GLQuadRenderer::render(const Group&,const DataSet*,RenderBuffer*) - renderBuffer must not be NULL");
+
+		if (!prg)
+			return;
+
 		GLBuffer& buffer = static_cast<GLBuffer&>(*renderBuffer);
 		buffer.positionAtStart(); // Repositions all the buffers at the start
 
@@ -223,14 +313,14 @@ namespace SPK
 		Math::Matrix trans;
 		root.render.GetTransform(TransformStage::WrldViewProj, trans);
 
-		prg->SetMatrix(ShaderType::Vertex, "view_proj", &trans, 1);
+		prg->SetMatrix(viewProjParam, &trans, 1);
 
 		trans.Identity();
-		prg->SetMatrix(ShaderType::Vertex, "trans", &trans, 1);
+		prg->SetMatrix(transParam, &trans, 1);
 
 		root.render.GetDevice()->SetVertexDecl(vdecl);
 
-		prg->SetTexture(ShaderType::Pixel, "diffuseMap", texture);
+		prg->SetTexture(diffuseMapParam, texture);
 
 		buffer.render(2/*GL_QUADS*/,group.getNbParticles());
 	}
@@ -57,11 +57,26 @@ namespace SPK
 	{
         SPK_IMPLEMENT_OBJECT(GLQuadRenderer);
 
+	SPK_START_DESCRIPTION
+	SPK_PARENT_ATTRIBUTES(GLRenderer)
+	SPK_ATTRIBUTE("texture",ATTRIBUTE_TYPE_STRING)
+	SPK_ATTRIBUTE("texturing mode",ATTRIBUTE_TYPE_INT32)
+	SPK_ATTRIBUTE("atlas dimensions",ATTRIBUTE_TYPE_UINT32S)
+	SPK_ATTRIBUTE("scale",ATTRIBUTE_TYPE_FLOATS)
+	SPK_ATTRIBUTE("orientation",ATTRIBUTE_TYPE_INT32S)
+	SPK_ATTRIBUTE("look vector",ATTRIBUTE_TYPE_VECTOR)
+	SPK_ATTRIBUTE("up vector",ATTRIBUTE_TYPE_VECTOR)
+	SPK_END_DESCRIPTION
+
 	public :
 
 		Oak::ProgramRef prg;
+		Oak::Program::Param viewProjParam;
+		Oak::Program::Param transParam;
+		Oak::Program::Param diffuseMapParam;
 		Oak::VertexDeclRef vdecl;
 		Oak::TextureRef texture;
+		std::string texturePath;
 
 		/**
 		* @brief Creates and registers a new GLQuadRenderer
@@ -79,6 +94,20 @@ namespace SPK
 
 		void setTexture(Oak::TextureRef texture);
 
+		/**
+		* @brief Sets a path of the texture, the texture is loaded by loadResources()
+		* @param path : the path of the texture
+		*/
+		void setTexture(const std::string& path);
+
+		/**
+		* @brief Creates render objects and loads the texture
+		*
+		* Renderer can be created and loaded on any thread, but resources are created only on the main thread.
+		* The renderer draws nothing until this method is called.
+		*/
+		void loadResources();
+
 		/////////////
 		// Getters //
 		/////////////
@@ -89,6 +118,17 @@ namespace SPK
 		*/
 		int getTexture() const;
 
+		/**
+		* @brief Gets the path of the texture of this GLQuadRenderer
+		* @return the path of the texture of this GLQuadRenderer
+		*/
+		const std::string& getTexturePath() const;
+
+	protected :
+
+		virtual void innerImport(const IO::Descriptor& descriptor) override;
+		virtual void innerExport(IO::Descriptor& descriptor) const override;
+
 	private :
 
 		mutable float modelView[16];
@@ -128,6 +168,13 @@ namespace SPK
 	inline void GLQuadRenderer::setTexture(Oak::TextureRef texture)
 	{
 		this->texture = texture;
+		texturePath = texture ? texture->GetName() : "";
+	}
+
+	inline void GLQuadRenderer::setTexture(const std::string& path)
+	{
+		texture = Oak::TextureRef();
+		texturePath = path;
 	}
 
 	inline int GLQuadRenderer::getTexture() const
@@ -135,6 +182,11 @@ namespace SPK
 		return textureIndex;
 	}
 
+	inline const std::string& GLQuadRenderer::getTexturePath() const
+	{
+		return texturePath;
+	}
+
 	inline void GLQuadRenderer::GLCallColorAndVertex(const Particle& particle,GLBuffer& renderBuffer) const
 	{
 		// quads are drawn in a counter clockwise order :
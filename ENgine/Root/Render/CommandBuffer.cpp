@@ -0,0 +1,490 @@
+
+#include "CommandBuffer.h"
+#include "Root/Root.h"
+#include <eastl/sort.h>
+
+namespace Oak
+{
+	eastl::vector<CommandBuffer::SortedItem> CommandBuffer::sortedItems;
+	eastl::vector<CommandBuffer::InstanceBuffer> CommandBuffer::instanceBuffers;
+
+	void CommandBuffer::SetProgram(Program* program)
+	{
+		curProgram = program;
+		curParams.clear();
+	}
+
+	void CommandBuffer::SetVertexDecl(VertexDecl* vdecl)
+	{
+		curVdecl = vdecl;
+	}
+
+	void CommandBuffer::SetVertexBuffer(DataBuffer* buffer)
+	{
+		curVBuffer = buffer;
+	}
+
+	void CommandBuffer::SetIndexBuffer(DataBuffer* buffer)
+	{
+		curIBuffer = buffer;
+	}
+
+	void CommandBuffer::SetParam(Program::Param param, ParamType type, const void* values, int count, Texture* texture)
+	{
+		if (param.index == -1)
+		{
+			return;
+		}
+
+		ParamValue* value = nullptr;
+
+		for (auto& curParam : curParams)
+		{
+			if (curParam.param.type == param.type && curParam.param.index == param.index)
+			{
+				value = &curParam;
+				break;
+			}
+		}
+
+		if (!value)
+		{
+			curParams.push_back(ParamValue());
+			value = &curParams.back();
+		}
+
+		value->param = param;
+		value->type = type;
+		value->texture = texture;
+		value->count = count;
+		value->offset = (int)data.size();
+
+		if (values)
+		{
+			int size = count * (type == ParamType::Matrix ? 4 : 1);
+
+			data.resize(data.size() + size);
+			memcpy(&data[value->offset], values, sizeof(Math::Vector4) * size);
+		}
+	}
+
+	void CommandBuffer::SetVector(Program::Param param, Math::Vector4* v, int count)
+	{
+		SetParam(param, ParamType::Vector, v, count, nullptr);
+	}
+
+	void CommandBuffer::SetMatrix(Program::Param param, Math::Matrix* mat, int count)
+	{
+		SetParam(param, ParamType::Matrix, mat, count, nullptr);
+	}
+
+	void CommandBuffer::SetTexture(Program::Param param, Texture* texture)
+	{
+		SetParam(param, ParamType::Texture, nullptr, 0, texture);
+	}
+
+	void CommandBuffer::SetDepth(float depth)
+	{
+		curDepth = depth;
+	}
+
+	void CommandBuffer::SetOrdered(bool set)
+	{
+		ordered = set;
+	}
+
+	void CommandBuffer::AddItem(PrimitiveTopology prim, bool indexed, int startVertex, int startIndex, int primCount)
+	{
+		if (!curProgram)
+		{
+			return;
+		}
+
+		items.push_back(Item());
+		Item& item = items.back();
+
+		item.ordered = ordered;
+		item.program = curProgram;
+		item.texture = nullptr;
+		item.depth = curDepth;
+		item.index = (int)items.size() - 1;
+		item.vdecl = curVdecl;
+		item.vbuffer = curVBuffer;
+		item.ibuffer = curIBuffer;
+		item.paramsFrom = (int)params.size();
+		item.paramsCount = (int)curParams.size();
+		item.prim = prim;
+		item.indexed = indexed;
+		item.startVertex = startVertex;
+		item.startIndex = startIndex;
+		item.primCount = primCount;
+		item.instanceOffset = 0;
+		item.instanceSize = 0;
+
+		for (auto& curParam : curParams)
+		{
+			if (!item.texture && curParam.type == ParamType::Texture)
+			{
+				item.texture = curParam.texture;
+			}
+
+			params.push_back(curParam);
+		}
+	}
+
+	void CommandBuffer::Draw(PrimitiveTopology prim, int startVertex, int primCount)
+	{
+		AddItem(prim, false, startVertex, 0, primCount);
+	}
+
+	void CommandBuffer::DrawIndexed(PrimitiveTopology prim, int startVertex, int startIndex, int primCount)
+	{
+		AddItem(prim, true, startVertex, startIndex, primCount);
+	}
+
+	void CommandBuffer::DrawIndexedInstance(PrimitiveTopology prim, int startVertex, int startIndex, int primCount, const void* instance, int size)
+	{
+		if (!curProgram)
+		{
+			return;
+		}
+
+		AddItem(prim, true, startVertex, startIndex, primCount);
+
+		Item& item = items.back();
+		item.instanceOffset = (int)data.size();
+		item.instanceSize = size;
+
+		data.resize(data.size() + (size + 15) / 16);
+		memcpy(&data[item.instanceOffset], instance, size);
+	}
+
+	bool CommandBuffer::IsEmpty()
+	{
+		return items.size() == 0;
+	}
+
+	void CommandBuffer::Reset()
+	{
+		items.clear();
+		params.clear();
+		data.clear();
+		curParams.clear();
+		curProgram = nullptr;
+		curVdecl = nullptr;
+		curVBuffer = nullptr;
+		curIBuffer = nullptr;
+		curDepth = 0.0f;
+		ordered = false;
+	}
+
+	int CommandBuffer::Execute(Device* device, CommandBuffer** buffers, int count)
+	{
+		sortedItems.clear();
+
+		for (int i = 0; i < count; i++)
+		{
+			for (auto& item : buffers[i]->items)
+			{
+				sortedItems.push_back({ &item, buffers[i], nullptr, 0, 1 });
+			}
+		}
+
+		eastl::sort(sortedItems.begin(), sortedItems.end(), [](const SortedItem& a, const SortedItem& b)
+		{
+			if (a.item->ordered != b.item->ordered) return b.item->ordered;
+
+			if (!a.item->ordered)
+			{
+				if (a.item->program != b.item->program) return a.item->program < b.item->program;
+				if (a.item->texture != b.item->texture) return a.item->texture < b.item->texture;
+				if (a.item->instanceSize != b.item->instanceSize) return a.item->instanceSize < b.item->instanceSize;
+
+				if (a.item->instanceSize > 0)
+				{
+					// instances of same geometry should become neighbours to be merged
+					if (a.item->vbuffer != b.item->vbuffer) return a.item->vbuffer < b.item->vbuffer;
+					if (a.item->ibuffer != b.item->ibuffer) return a.item->ibuffer < b.item->ibuffer;
+					if (a.item->startIndex != b.item->startIndex) return a.item->startIndex < b.item->startIndex;
+				}
+				if (a.item->depth != b.item->depth) return a.item->depth < b.item->depth;
+			}
+
+			if (a.buffer != b.buffer) return a.buffer < b.buffer;
+
+			return a.item->index < b.item->index;
+		});
+
+		MergeInstances(device);
+
+		int replayed = (int)sortedItems.size();
+		int lists = eastl::min(device->GetCommandListsCount(), root.taskExecutor.GetWorkersCount() + 1);
+
+		if (replayed / minItemsPerList < lists)
+		{
+			lists = replayed / minItemsPerList;
+		}
+
+		if (lists > 1)
+		{
+			// ranges of sorted items are recorded on worker threads and executed in same order
+			ReplayJob job;
+			job.device = device;
+			job.itemsPerList = (replayed + lists - 1) / lists;
+
+			// workers can't flush batched geometry, so it is drawn before recording of lists
+			device->FlushBatch();
+
+			root.taskExecutor.ExecuteParallel(&job, lists, 1);
+
+			for (int i = 0; i < lists; i++)
+			{
+				device->ExecuteCommandList(i);
+			}
+		}
+		else
+		{
+			Replay(device, 0, replayed);
+		}
+
+		sortedItems.clear();
+
+		for (int i = 0; i < count; i++)
+		{
+			buffers[i]->Reset();
+		}
+
+		return replayed;
+	}
+
+	bool CommandBuffer::CanMerge(const SortedItem& a, const SortedItem& b)
+	{
+		Item& itemA = *a.item;
+		Item& itemB = *b.item;
+
+		if (itemA.ordered != itemB.ordered || itemA.program != itemB.program || itemA.vdecl != itemB.vdecl ||
+			itemA.vbuffer != itemB.vbuffer || itemA.ibuffer != itemB.ibuffer || itemA.prim != itemB.prim ||
+			itemA.startVertex != itemB.startVertex || itemA.startIndex != itemB.startIndex || itemA.primCount != itemB.primCount ||
+			itemA.instanceSize != itemB.instanceSize || itemA.paramsCount != itemB.paramsCount)
+		{
+			return false;
+		}
+
+		for (int i = 0; i < itemA.paramsCount; i++)
+		{
+			ParamValue& valueA = a.buffer->params[itemA.paramsFrom + i];
+			ParamValue& valueB = b.buffer->params[itemB.paramsFrom + i];
+
+			if (valueA.param.type != valueB.param.type || valueA.param.index != valueB.param.index ||
+				valueA.type != valueB.type || valueA.count != valueB.count || valueA.texture != valueB.texture)
+			{
+				return false;
+			}
+
+			if (valueA.type != ParamType::Texture)
+			{
+				int size = valueA.count * (valueA.type == ParamType::Matrix ? 4 : 1);
+
+				if (memcmp(&a.buffer->data[valueA.offset], &b.buffer->data[valueB.offset], sizeof(Math::Vector4) * size) != 0)
+				{
+					return false;
+				}
+			}
+		}
+
+		return true;
+	}
+
+	void CommandBuffer::MergeInstances(Device* device)
+	{
+		for (auto& instanceBuffer : instanceBuffers)
+		{
+			instanceBuffer.data.clear();
+		}
+
+		int count = 0;
+
+		for (int index = 0; index < (int)sortedItems.size(); index++)
+		{
+			SortedItem sortedItem = sortedItems[index];
+			Item& item = *sortedItem.item;
+
+			if (item.instanceSize == 0)
+			{
+				sortedItems[count++] = sortedItem;
+				continue;
+			}
+
+			InstanceBuffer* instanceBuffer = nullptr;
+
+			for (auto& buffer : instanceBuffers)
+			{
+				if (buffer.stride == item.instanceSize)
+				{
+					instanceBuffer = &buffer;
+					break;
+				}
+			}
+
+			if (!instanceBuffer)
+			{
+				instanceBuffers.push_back(InstanceBuffer());
+				instanceBuffer = &instanceBuffers.back();
+				instanceBuffer->stride = item.instanceSize;
+			}
+
+			if (count > 0 && CanMerge(sortedItems[count - 1], sortedItem))
+			{
+				sortedItems[count - 1].instanceCount++;
+			}
+			else
+			{
+				sortedItem.startInstance = (int)instanceBuffer->data.size() / instanceBuffer->stride;
+				sortedItems[count++] = sortedItem;
+			}
+
+			uint8_t* instance = (uint8_t*)&sortedItem.buffer->data[item.instanceOffset];
+			instanceBuffer->data.insert(instanceBuffer->data.end(), instance, instance + item.instanceSize);
+		}
+
+		sortedItems.resize(count);
+
+		for (auto& instanceBuffer : instanceBuffers)
+		{
+			int instances = (int)instanceBuffer.data.size() / instanceBuffer.stride;
+
+			if (instances == 0)
+			{
+				continue;
+			}
+
+			if (instances > instanceBuffer.capacity)
+			{
+				instanceBuffer.capacity = eastl::max(instances, instanceBuffer.capacity * 2);
+				instanceBuffer.buffer = device->CreateBuffer(instanceBuffer.capacity, instanceBuffer.stride, _FL_);
+			}
+
+			memcpy(instanceBuffer.buffer->Lock(), instanceBuffer.data.data(), instanceBuffer.data.size());
+			instanceBuffer.buffer->Unlock();
+		}
+
+		for (auto& sortedItem : sortedItems)
+		{
+			if (sortedItem.item->instanceSize == 0)
+			{
+				continue;
+			}
+
+			for (auto& instanceBuffer : instanceBuffers)
+			{
+				if (instanceBuffer.stride == sortedItem.item->instanceSize)
+				{
+					sortedItem.instances = instanceBuffer.buffer;
+					break;
+				}
+			}
+		}
+	}
+
+	void CommandBuffer::ReleaseInstanceBuffers()
+	{
+		instanceBuffers.clear();
+	}
+
+	void CommandBuffer::ReplayJob::Execute(int from, int to)
+	{
+		for (int i = from; i < to; i++)
+		{
+			int itemsFrom = i * itemsPerList;
+			int itemsTo = eastl::min(itemsFrom + itemsPerList, (int)sortedItems.size());
+
+			device->BeginCommandList(i);
+
+			Replay(device, itemsFrom, itemsTo);
+
+			device->EndCommandList();
+		}
+	}
+
+	void CommandBuffer::Replay(Device* device, int from, int to)
+	{
+		Program* program = nullptr;
+		VertexDecl* vdecl = nullptr;
+		DataBuffer* vbuffer = nullptr;
+		DataBuffer* ibuffer = nullptr;
+		DataBuffer* instances = nullptr;
+		bool first = true;
+
+		for (int index = from; index < to; index++)
+		{
+			SortedItem& sortedItem = sortedItems[index];
+			Item& item = *sortedItem.item;
+			CommandBuffer* buffer = sortedItem.buffer;
+
+			if (first || program != item.program)
+			{
+				program = item.program;
+				device->SetProgram(program);
+			}
+
+			if (first || vdecl != item.vdecl)
+			{
+				vdecl = item.vdecl;
+				device->SetVertexDecl(vdecl);
+			}
+
+			if (first || vbuffer != item.vbuffer)
+			{
+				vbuffer = item.vbuffer;
+				device->SetVertexBuffer(0, vbuffer);
+			}
+
+			if (item.indexed && (first || ibuffer != item.ibuffer))
+			{
+				ibuffer = item.ibuffer;
+				device->SetIndexBuffer(ibuffer);
+			}
+
+			if (item.instanceSize > 0 && (first || instances != sortedItem.instances))
+			{
+				instances = sortedItem.instances;
+				device->SetVertexBuffer(1, instances);
+			}
+
+			first = false;
+
+			for (int i = item.paramsFrom; i < item.paramsFrom + item.paramsCount; i++)
+			{
+				ParamValue& value = buffer->params[i];
+
+				if (value.type == ParamType::Vector)
+				{
+					program->SetVector(value.param, &buffer->data[value.offset], value.count);
+				}
+				else
+				if (value.type == ParamType::Matrix)
+				{
+					program->SetMatrix(value.param, (Math::Matrix*)&buffer->data[value.offset], value.count);
+				}
+				else
+				{
+					program->SetTexture(value.param, value.texture);
+				}
+			}
+
+			if (item.instanceSize > 0)
+			{
+				device->DrawIndexedInstanced(item.prim, item.startVertex, item.startIndex, item.primCount, sortedItem.startInstance, sortedItem.instanceCount);
+			}
+			else
+			if (item.indexed)
+			{
+				device->DrawIndexed(item.prim, item.startVertex, item.startIndex, item.primCount);
+			}
+			else
+			{
+				device->Draw(item.prim, item.startVertex, item.primCount);
+			}
+		}
+	}
+}
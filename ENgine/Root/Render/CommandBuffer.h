@@ -0,0 +1,251 @@
+
+#pragma once
+
+#include "Root/Render/Device.h"
+#include "Root/TaskExecutor/TaskExecutor.h"
+#include <eastl/vector.h>
+
+namespace Oak
+{
+	/**
+	\ingroup gr_code_root_render
+	*/
+
+	/**
+	\brief CommandBuffer
+
+	Buffer records render commands instead of calling Device. Every draw call becomes a draw item
+	which captures program, vertex declaration, buffers and parameters set before the draw. Recorded
+	items are sorted by program, texture and depth and replayed with skipping of redundant changes of
+	a state. Draws of single instances which are equal except of instance data are merged into one
+	instanced draw call. Items recorded in ordered mode keep order of submission and are replayed after sorted ones.
+	Recording doesn't touch Device, so each thread can record into own buffer. If device supports
+	command lists big replays are split into ranges which are recorded on worker threads.
+
+	*/
+
+	class CLASS_DECLSPEC CommandBuffer
+	{
+		#ifndef DOXYGEN_SKIP
+
+		enum class ParamType
+		{
+			Vector,
+			Matrix,
+			Texture
+		};
+
+		struct ParamValue
+		{
+			Program::Param param;
+			ParamType type;
+			int offset = 0;
+			int count = 0;
+			Texture* texture = nullptr;
+		};
+
+		struct Item
+		{
+			bool ordered;
+			Program* program;
+			Texture* texture;
+			float depth;
+			int index;
+			VertexDecl* vdecl;
+			DataBuffer* vbuffer;
+			DataBuffer* ibuffer;
+			int paramsFrom;
+			int paramsCount;
+			PrimitiveTopology prim;
+			bool indexed;
+			int startVertex;
+			int startIndex;
+			int primCount;
+			int instanceOffset;
+			int instanceSize;
+		};
+
+		struct SortedItem
+		{
+			Item* item;
+			CommandBuffer* buffer;
+			DataBuffer* instances;
+			int startInstance;
+			int instanceCount;
+		};
+
+		// instance data of merged items is uploaded into buffer per size of instance
+		struct InstanceBuffer
+		{
+			int stride = 0;
+			int capacity = 0;
+			DataBufferRef buffer;
+			eastl::vector<uint8_t> data;
+		};
+
+		eastl::vector<Item> items;
+		eastl::vector<ParamValue> params;
+		eastl::vector<Math::Vector4> data;
+
+		eastl::vector<ParamValue> curParams;
+		Program* curProgram = nullptr;
+		VertexDecl* curVdecl = nullptr;
+		DataBuffer* curVBuffer = nullptr;
+		DataBuffer* curIBuffer = nullptr;
+		float curDepth = 0.0f;
+		bool ordered = false;
+
+		struct ReplayJob : TaskExecutor::ParallelJob
+		{
+			Device* device = nullptr;
+			int itemsPerList = 0;
+
+			void Execute(int from, int to) override;
+		};
+
+		constexpr static int minItemsPerList = 64;
+
+		static eastl::vector<SortedItem> sortedItems;
+		static eastl::vector<InstanceBuffer> instanceBuffers;
+
+		static bool CanMerge(const SortedItem& a, const SortedItem& b);
+		static void MergeInstances(Device* device);
+		static void Replay(Device* device, int from, int to);
+
+		void SetParam(Program::Param param, ParamType type, const void* values, int count, Texture* texture);
+		void AddItem(PrimitiveTopology prim, bool indexed, int startVertex, int startIndex, int primCount);
+
+		#endif
+
+	public:
+
+		/**
+		\brief Set program for next draw items. All parameters set before are dropped.
+
+		\param[in] program Pointer to a program
+		*/
+		void SetProgram(Program* program);
+
+		/**
+		\brief Set vertex declaration for next draw items
+
+		\param[in] vdecl Pointer to a vertex declaration
+		*/
+		void SetVertexDecl(VertexDecl* vdecl);
+
+		/**
+		\brief Set vertex buffer for next draw items
+
+		\param[in] buffer Pointer to a buffer
+		*/
+		void SetVertexBuffer(DataBuffer* buffer);
+
+		/**
+		\brief Set index buffer for next draw items
+
+		\param[in] buffer Pointer to a buffer
+		*/
+		void SetIndexBuffer(DataBuffer* buffer);
+
+		/**
+		\brief Set 4 component vectors for a parameter of current program. Values are copied.
+
+		\param[in] param Handle of a parameter
+		\param[in] v Pointer to vectors
+		\param[in] count Number of vectors
+		*/
+		void SetVector(Program::Param param, Math::Vector4* v, int count);
+
+		/**
+		\brief Set matrices for a parameter of current program. Values are copied.
+
+		\param[in] param Handle of a parameter
+		\param[in] mat Pointer to matrices
+		\param[in] count Number of matrices
+		*/
+		void SetMatrix(Program::Param param, Math::Matrix* mat, int count);
+
+		/**
+		\brief Set texture for a parameter of current program. First texture of draw item is used for sorting.
+
+		\param[in] param Handle of a parameter
+		\param[in] texture Pointer to a texture
+		*/
+		void SetTexture(Program::Param param, Texture* texture);
+
+		/**
+		\brief Set depth of next draw items. Items with same program and texture are replayed from near to far.
+
+		\param[in] depth Depth in view space
+		*/
+		void SetDepth(float depth);
+
+		/**
+		\brief Controls ordered mode. Items recorded in ordered mode aren't sorted.
+
+		\param[in] set Should ordered mode be enabled
+		*/
+		void SetOrdered(bool set);
+
+		/**
+		\brief Record draw of primitives
+
+		\param[in] prim Primitives type
+		\param[in] startVertex Index of start vertex
+		\param[in] primCount Count of primitives
+		*/
+		void Draw(PrimitiveTopology prim, int startVertex, int primCount);
+
+		/**
+		\brief Record draw of indexed primitives
+
+		\param[in] prim Primitives type
+		\param[in] startVertex Index of start vertex
+		\param[in] startIndex Index of start index
+		\param[in] primCount Count of primitives
+		*/
+		void DrawIndexed(PrimitiveTopology prim, int startVertex, int startIndex, int primCount);
+
+		/**
+		\brief Record draw of one instance of indexed primitives. Vertex declaration should have instanced
+		elements which describe instance data. Consecutive sorted items with same state and parameters are
+		drawn by one instanced draw call.
+
+		\param[in] prim Primitives type
+		\param[in] startVertex Index of start vertex
+		\param[in] startIndex Index of start index
+		\param[in] primCount Count of primitives
+		\param[in] instance Pointer to data of an instance. Data is copied.
+		\param[in] size Size of data of an instance. Should be multiple of 16.
+		*/
+		void DrawIndexedInstance(PrimitiveTopology prim, int startVertex, int startIndex, int primCount, const void* instance, int size);
+
+		/**
+		\brief Check if buffer has recorded draw items
+
+		\return True will be returned if buffer is empty
+		*/
+		bool IsEmpty();
+
+		/**
+		\brief Drop all recorded commands
+		*/
+		void Reset();
+
+		/**
+		\brief Sort draw items of several buffers together, replay them via a device and reset buffers.
+		Should be called from a thread which owns a device.
+
+		\param[in] device Pointer to a device
+		\param[in] buffers Array of buffers
+		\param[in] count Number of buffers
+
+		\return Number of replayed draw items
+		*/
+		static int Execute(Device* device, CommandBuffer** buffers, int count);
+
+		#ifndef DOXYGEN_SKIP
+		static void ReleaseInstanceBuffers();
+		#endif
+	};
+}
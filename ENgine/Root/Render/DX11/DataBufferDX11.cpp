@@ -33,6 +33,9 @@ namespace Oak
 
 	void DataBufferDX11::Release()
 	{
+		// device shouldn't skip binding of a new buffer which got same address
+		DeviceDX11::instance->ResetBuffers(this);
+
 		RELEASE(buffer)
 
 		delete this;
@@ -10,75 +10,58 @@ namespace Oak
 {
 	DeviceDX11* DeviceDX11::instance = nullptr;
 
+	static thread_local int curContext = 0;
+
 	DeviceDX11::DeviceDX11()
 	{
 		instance = this;
 
-		blend_desc = NEW D3D11_BLEND_DESC();
-		ZeroMemory(blend_desc, sizeof(D3D11_BLEND_DESC));
-		blend_state = nullptr;
-		blend_changed = true;
-
-		ds_desc = NEW D3D11_DEPTH_STENCIL_DESC();
-		ZeroMemory(ds_desc, sizeof(D3D11_DEPTH_STENCIL_DESC));
-		ds_state = nullptr;
-		ds_changed = true;
-
-		raster_desc = NEW D3D11_RASTERIZER_DESC();
-		ZeroMemory(raster_desc, sizeof(D3D11_RASTERIZER_DESC));
-		raster_state = nullptr;
-		raster_changed = true;
-
-		blend_desc->RenderTarget[0].BlendEnable = false;
-
-		blend_desc->RenderTarget[0].SrcBlend = D3D11_BLEND_SRC_ALPHA;
-		blend_desc->RenderTarget[0].DestBlend = D3D11_BLEND_INV_SRC_ALPHA;
-		blend_desc->RenderTarget[0].BlendOp = D3D11_BLEND_OP_ADD;
-		blend_desc->RenderTarget[0].SrcBlendAlpha = D3D11_BLEND_ONE;
-		blend_desc->RenderTarget[0].DestBlendAlpha = D3D11_BLEND_ONE;
-		blend_desc->RenderTarget[0].BlendOpAlpha = D3D11_BLEND_OP_ADD;
-		blend_desc->RenderTarget[0].RenderTargetWriteMask = D3D11_COLOR_WRITE_ENABLE_ALL;
-
-
-		ds_desc->DepthEnable = true;
-		ds_desc->DepthWriteMask = D3D11_DEPTH_WRITE_MASK_ALL;
-		ds_desc->DepthFunc = D3D11_COMPARISON_LESS;
-
-		ds_desc->StencilEnable = false;
-		ds_desc->StencilReadMask = 0xFF;
-		ds_desc->StencilWriteMask = 0xFF;
-
-		ds_desc->FrontFace.StencilFailOp = D3D11_STENCIL_OP_KEEP;
-		ds_desc->FrontFace.StencilDepthFailOp = D3D11_STENCIL_OP_INCR;
-		ds_desc->FrontFace.StencilPassOp = D3D11_STENCIL_OP_KEEP;
-		ds_desc->FrontFace.StencilFunc = D3D11_COMPARISON_ALWAYS;
-
-		ds_desc->BackFace.StencilFailOp = D3D11_STENCIL_OP_KEEP;
-		ds_desc->BackFace.StencilDepthFailOp = D3D11_STENCIL_OP_DECR;
-		ds_desc->BackFace.StencilPassOp = D3D11_STENCIL_OP_KEEP;
-		ds_desc->BackFace.StencilFunc = D3D11_COMPARISON_ALWAYS;
-
-		raster_desc->AntialiasedLineEnable = false;
-		raster_desc->CullMode = D3D11_CULL_BACK;
-		raster_desc->DepthBias = 0;
-		raster_desc->DepthBiasClamp = 0.0f;
-		raster_desc->DepthClipEnable = false;
-
-		raster_desc->FillMode = D3D11_FILL_SOLID;
-		raster_desc->FrontCounterClockwise = false;
-		raster_desc->MultisampleEnable = false;
-		raster_desc->ScissorEnable = false;
-		raster_desc->SlopeScaledDepthBias = 0.0f;
+		Context& ctx = contexts[0];
 
-		for (int i = 0; i < 6; i++)
-		{
-			cur_rt[i] = nullptr;
-		}
+		ZeroMemory(&ctx.blend_desc, sizeof(D3D11_BLEND_DESC));
+		ZeroMemory(&ctx.ds_desc, sizeof(D3D11_DEPTH_STENCIL_DESC));
+		ZeroMemory(&ctx.raster_desc, sizeof(D3D11_RASTERIZER_DESC));
+
+		ctx.blend_desc.RenderTarget[0].BlendEnable = false;
+
+		ctx.blend_desc.RenderTarget[0].SrcBlend = D3D11_BLEND_SRC_ALPHA;
+		ctx.blend_desc.RenderTarget[0].DestBlend = D3D11_BLEND_INV_SRC_ALPHA;
+		ctx.blend_desc.RenderTarget[0].BlendOp = D3D11_BLEND_OP_ADD;
+		ctx.blend_desc.RenderTarget[0].SrcBlendAlpha = D3D11_BLEND_ONE;
+		ctx.blend_desc.RenderTarget[0].DestBlendAlpha = D3D11_BLEND_ONE;
+		ctx.blend_desc.RenderTarget[0].BlendOpAlpha = D3D11_BLEND_OP_ADD;
+		ctx.blend_desc.RenderTarget[0].RenderTargetWriteMask = D3D11_COLOR_WRITE_ENABLE_ALL;
+
+
+		ctx.ds_desc.DepthEnable = true;
+		ctx.ds_desc.DepthWriteMask = D3D11_DEPTH_WRITE_MASK_ALL;
+		ctx.ds_desc.DepthFunc = D3D11_COMPARISON_LESS;
+
+		ctx.ds_desc.StencilEnable = false;
+		ctx.ds_desc.StencilReadMask = 0xFF;
+		ctx.ds_desc.StencilWriteMask = 0xFF;
+
+		ctx.ds_desc.FrontFace.StencilFailOp = D3D11_STENCIL_OP_KEEP;
+		ctx.ds_desc.FrontFace.StencilDepthFailOp = D3D11_STENCIL_OP_INCR;
+		ctx.ds_desc.FrontFace.StencilPassOp = D3D11_STENCIL_OP_KEEP;
+		ctx.ds_desc.FrontFace.StencilFunc = D3D11_COMPARISON_ALWAYS;
+
+		ctx.ds_desc.BackFace.StencilFailOp = D3D11_STENCIL_OP_KEEP;
+		ctx.ds_desc.BackFace.StencilDepthFailOp = D3D11_STENCIL_OP_DECR;
+		ctx.ds_desc.BackFace.StencilPassOp = D3D11_STENCIL_OP_KEEP;
+		ctx.ds_desc.BackFace.StencilFunc = D3D11_COMPARISON_ALWAYS;
 
-		cur_depth = nullptr;
-		need_set_rt = true;
+		ctx.raster_desc.AntialiasedLineEnable = false;
+		ctx.raster_desc.CullMode = D3D11_CULL_BACK;
+		ctx.raster_desc.DepthBias = 0;
+		ctx.raster_desc.DepthBiasClamp = 0.0f;
+		ctx.raster_desc.DepthClipEnable = false;
 
-		vp_was_setted = false;
+		ctx.raster_desc.FillMode = D3D11_FILL_SOLID;
+		ctx.raster_desc.FrontCounterClockwise = false;
+		ctx.raster_desc.MultisampleEnable = false;
+		ctx.raster_desc.ScissorEnable = false;
+		ctx.raster_desc.SlopeScaledDepthBias = 0.0f;
 	}
 
 	bool DeviceDX11::Init(void* external_device)
@@ -142,6 +125,24 @@ namespace Oak
 			}
 		}
 
+		contexts[0].context = immediateContext;
+
+		// deferred contexts are used only if there are threads to record them
+		int workers = root.taskExecutor.GetWorkersCount();
+
+		if (workers > 0)
+		{
+			int count = workers + 1 < maxContexts ? workers + 1 : maxContexts;
+
+			for (contextsCount = 1; contextsCount < count; contextsCount++)
+			{
+				if (pd3dDevice->CreateDeferredContext(0, &contexts[contextsCount].context) < 0)
+				{
+					break;
+				}
+			}
+		}
+
 		return true;
 	}
 
@@ -319,38 +320,50 @@ namespace Oak
 
 	void DeviceDX11::Clear(bool renderTarget, Color color, bool zbuffer, float zValue)
 	{
+		Context& ctx = GetContext();
+
+		FlushBatch();
+
 		if (renderTarget)
 		{
 			for (int i = 0; i < 6; i++)
 			{
-				if (cur_rt[i])
+				if (ctx.cur_rt[i])
 				{
-					immediateContext->ClearRenderTargetView(cur_rt[i], (float*)&color.r);
+					ctx.context->ClearRenderTargetView(ctx.cur_rt[i], (float*)&color.r);
 				}
 			}
 		}
 
-		if (zbuffer && cur_depth)
+		if (zbuffer && ctx.cur_depth)
 		{
-			immediateContext->ClearDepthStencilView(cur_depth, D3D11_CLEAR_DEPTH, zValue, 0);
+			ctx.context->ClearDepthStencilView(ctx.cur_depth, D3D11_CLEAR_DEPTH, zValue, 0);
 		}
 	}
 
 	void DeviceDX11::Present()
 	{
+		Context& ctx = GetContext();
+
+		FlushBatch();
+
+		// buffers could be rebound by external code like ImGui renderer
+		ResetBuffers();
+		ResetBindings(ctx, false);
+
 		if (swapChain)
 		{
 			swapChain->Present(0, 0);
-			need_set_rt = true;
+			ctx.need_set_rt = true;
 		}
 		else
 		{
-			need_set_rt = true;
-			need_apply_vdecl = true;
-			need_apply_prog = true;
-			blend_changed = true;
-			ds_changed = true;
-			raster_changed = true;
+			ctx.need_set_rt = true;
+			ctx.need_apply_vdecl = true;
+			ctx.need_apply_prog = true;
+			ctx.blend_changed = true;
+			ctx.ds_changed = true;
+			ctx.raster_changed = true;
 		}
 	}
 
@@ -361,11 +374,15 @@ namespace Oak
 
 	void DeviceDX11::SetProgram(Program* program)
 	{
-		if (cur_program != program)
+		Context& ctx = GetContext();
+
+		FlushBatch();
+
+		if (ctx.cur_program != program)
 		{
-			cur_program = program;
-			need_apply_prog = true;
-			need_apply_vdecl = true;
+			ctx.cur_program = program;
+			ctx.need_apply_prog = true;
+			ctx.need_apply_vdecl = true;
 		}
 	}
 
@@ -376,10 +393,14 @@ namespace Oak
 
 	void DeviceDX11::SetVertexDecl(VertexDecl* vdecl)
 	{
-		if (cur_vdecl != vdecl)
+		Context& ctx = GetContext();
+
+		FlushBatch();
+
+		if (ctx.cur_vdecl != vdecl)
 		{
-			need_apply_vdecl = true;
-			cur_vdecl = (VertexDeclDX11*)vdecl;
+			ctx.need_apply_vdecl = true;
+			ctx.cur_vdecl = (VertexDeclDX11*)vdecl;
 		}
 	}
 
@@ -388,8 +409,43 @@ namespace Oak
 		return DataBufferRef(new(file, line) DataBufferDX11(count, stride), file, line);
 	}
 
+	void DeviceDX11::ResetBuffers(DataBuffer* buffer)
+	{
+		for (int i = 0; i < contextsCount; i++)
+		{
+			Context& ctx = contexts[i];
+
+			for (auto& vbuffer : ctx.cur_vbuffers)
+			{
+				if (!buffer || vbuffer == buffer)
+				{
+					vbuffer = nullptr;
+				}
+			}
+
+			if (!buffer || ctx.cur_ibuffer == buffer)
+			{
+				ctx.cur_ibuffer = nullptr;
+			}
+		}
+	}
+
 	void DeviceDX11::SetVertexBuffer(int slot, DataBuffer* buffer)
 	{
+		Context& ctx = GetContext();
+
+		FlushBatch();
+
+		if (slot < 4 && buffer && ctx.cur_vbuffers[slot] == buffer)
+		{
+			return;
+		}
+
+		if (slot < 4)
+		{
+			ctx.cur_vbuffers[slot] = buffer;
+		}
+
 		ID3D11Buffer* vb = nullptr;
 		unsigned int stride = 0;
 
@@ -400,11 +456,22 @@ namespace Oak
 		}
 
 		unsigned int offset = 0;
-		immediateContext->IASetVertexBuffers(slot, 1, &vb, &stride, &offset);
+		ctx.context->IASetVertexBuffers(slot, 1, &vb, &stride, &offset);
 	}
 
 	void DeviceDX11::SetIndexBuffer(DataBuffer* buffer)
 	{
+		Context& ctx = GetContext();
+
+		FlushBatch();
+
+		if (buffer && ctx.cur_ibuffer == buffer)
+		{
+			return;
+		}
+
+		ctx.cur_ibuffer = buffer;
+
 		ID3D11Buffer* ib = nullptr;
 		DXGI_FORMAT fmt = DXGI_FORMAT_R16_UINT;
 
@@ -417,7 +484,7 @@ namespace Oak
 			}
 		}
 
-		immediateContext->IASetIndexBuffer(ib, fmt, 0);
+		ctx.context->IASetIndexBuffer(ib, fmt, 0);
 	}
 
 	Shader* DeviceDX11::CreateShader(ShaderType type, const char* name)
@@ -498,77 +565,129 @@ namespace Oak
 
 	void DeviceDX11::Draw(PrimitiveTopology prim, int startVertex, int primCount)
 	{
+		Context& ctx = GetContext();
+
+		FlushBatch();
+
 		UpdateStates();
 
-		immediateContext->IASetPrimitiveTopology((D3D_PRIMITIVE_TOPOLOGY)GetPrimitiveType(prim));
-		immediateContext->Draw(CalcPrimCount(prim, primCount), startVertex);
+		ctx.context->IASetPrimitiveTopology((D3D_PRIMITIVE_TOPOLOGY)GetPrimitiveType(prim));
+		ctx.context->Draw(CalcPrimCount(prim, primCount), startVertex);
 	}
 
 	void DeviceDX11::DrawIndexed(PrimitiveTopology prim, int startVertex, int startIndex, int primCount)
 	{
+		Context& ctx = GetContext();
+
+		FlushBatch();
+
 		UpdateStates();
 
-		immediateContext->IASetPrimitiveTopology((D3D_PRIMITIVE_TOPOLOGY)GetPrimitiveType(prim));
-		immediateContext->DrawIndexed(CalcPrimCount(prim, primCount), startIndex, startVertex);
+		ctx.context->IASetPrimitiveTopology((D3D_PRIMITIVE_TOPOLOGY)GetPrimitiveType(prim));
+		ctx.context->DrawIndexed(CalcPrimCount(prim, primCount), startIndex, startVertex);
+	}
+
+	void DeviceDX11::DrawIndexedInstanced(PrimitiveTopology prim, int startVertex, int startIndex, int primCount, int startInstance, int instanceCount)
+	{
+		Context& ctx = GetContext();
+
+		FlushBatch();
+
+		UpdateStates();
+
+		ctx.context->IASetPrimitiveTopology((D3D_PRIMITIVE_TOPOLOGY)GetPrimitiveType(prim));
+		ctx.context->DrawIndexedInstanced(CalcPrimCount(prim, primCount), instanceCount, startIndex, startVertex, startInstance);
 	}
 
 
 	void DeviceDX11::SetAlphaBlend(bool enable)
 	{
-		blend_desc->RenderTarget[0].BlendEnable = enable;
+		Context& ctx = GetContext();
+
+		FlushBatch();
 
-		blend_changed = true;
+		ctx.blend_desc.RenderTarget[0].BlendEnable = enable;
+
+		ctx.blend_changed = true;
 	}
 
 	void DeviceDX11::SetBlendFunc(BlendArg src, BlendArg dest)
 	{
-		blend_desc->RenderTarget[0].SrcBlend = (D3D11_BLEND)((int)src + 1);
-		blend_desc->RenderTarget[0].DestBlend = (D3D11_BLEND)((int)dest + 1);
+		Context& ctx = GetContext();
+
+		FlushBatch();
 
-		blend_changed = true;
+		ctx.blend_desc.RenderTarget[0].SrcBlend = (D3D11_BLEND)((int)src + 1);
+		ctx.blend_desc.RenderTarget[0].DestBlend = (D3D11_BLEND)((int)dest + 1);
+
+		ctx.blend_changed = true;
 	}
 
 	void DeviceDX11::SetBlendOperation(BlendOp op)
 	{
-		blend_desc->RenderTarget[0].BlendOp = (D3D11_BLEND_OP)((int)op + 1);
+		Context& ctx = GetContext();
+
+		FlushBatch();
+
+		ctx.blend_desc.RenderTarget[0].BlendOp = (D3D11_BLEND_OP)((int)op + 1);
 
-		blend_changed = true;
+		ctx.blend_changed = true;
 	}
 
 	void DeviceDX11::SetDepthTest(bool enable)
 	{
-		ds_desc->DepthEnable = enable;
-		ds_changed = true;
+		Context& ctx = GetContext();
+
+		FlushBatch();
+
+		ctx.ds_desc.DepthEnable = enable;
+		ctx.ds_changed = true;
 	}
 
 	void DeviceDX11::SetDepthWriting(bool enable)
 	{
+		Context& ctx = GetContext();
+
+		FlushBatch();
+
 		if (enable)
 		{
-			ds_desc->DepthWriteMask = D3D11_DEPTH_WRITE_MASK_ALL;
+			ctx.ds_desc.DepthWriteMask = D3D11_DEPTH_WRITE_MASK_ALL;
 		}
 		else
 		{
-			ds_desc->DepthWriteMask = D3D11_DEPTH_WRITE_MASK_ZERO;
+			ctx.ds_desc.DepthWriteMask = D3D11_DEPTH_WRITE_MASK_ZERO;
 		}
 
-		ds_changed = true;
+		ctx.ds_changed = true;
 	}
 
 	void DeviceDX11::SetDepthFunc(CompareFunc func)
 	{
-		ds_desc->DepthFunc = (D3D11_COMPARISON_FUNC)((int)func + 1);
-		ds_changed = true;
+		Context& ctx = GetContext();
+
+		FlushBatch();
+
+		ctx.ds_desc.DepthFunc = (D3D11_COMPARISON_FUNC)((int)func + 1);
+		ctx.ds_changed = true;
 	}
 
 	void DeviceDX11::SetCulling(CullMode mode)
 	{
-		raster_desc->CullMode = (D3D11_CULL_MODE)((int)mode + 1);
-		raster_changed = true;
+		Context& ctx = GetContext();
+
+		FlushBatch();
+
+		ctx.raster_desc.CullMode = (D3D11_CULL_MODE)((int)mode + 1);
+		ctx.raster_changed = true;
 	}
 
 	void DeviceDX11::SetupSlopeZBias(bool enable, float slopeZBias, float depthOffset)
 	{
+		Context& ctx = GetContext();
+
+		FlushBatch();
+
 		float curDepthBias = 0.0f;
 		float curBiasSlope = 0.0f;
 
@@ -578,24 +697,29 @@ namespace Oak
 			curBiasSlope = slopeZBias;
 		}
 
-		raster_desc->DepthBias = (int)(curDepthBias / (1.0f / pow(2, 23)));
-		raster_desc->SlopeScaledDepthBias = curBiasSlope;
+		ctx.raster_desc.DepthBias = (int)(curDepthBias / (1.0f / pow(2, 23)));
+		ctx.raster_desc.SlopeScaledDepthBias = curBiasSlope;
 
-		raster_changed = true;
+		ctx.raster_changed = true;
 	}
 
 	void DeviceDX11::UpdateStates()
 	{
-		if (need_set_rt)
+		Context& ctx = GetContext();
+
+		if (ctx.need_set_rt)
 		{
 			ID3D11ShaderResourceView* emties[] = {nullptr, nullptr};
-			DeviceDX11::instance->immediateContext->PSSetShaderResources(0, 2, emties);
+			ctx.context->PSSetShaderResources(0, 2, emties);
+
+			// new render target could be bound as a texture, runtime unbinds such textures
+			ResetBindings(ctx, true);
 
 			int count = 0;
 
 			for (int i = 0; i < 6; i++)
 			{
-				if (cur_rt[i])
+				if (ctx.cur_rt[i])
 				{
 					count++;
 				}
@@ -605,35 +729,36 @@ namespace Oak
 				}
 			}
 
-			immediateContext->OMSetRenderTargets(count, cur_rt, cur_depth);
-			need_set_rt = false;
+			ctx.context->OMSetRenderTargets(count, ctx.cur_rt, ctx.cur_depth);
+			ctx.need_set_rt = false;
 
 			D3D11_VIEWPORT vp;
 
-			if (cur_rt[0])
+			if (ctx.cur_rt[0])
 			{
-				vp.Width = (FLOAT)cur_rt_w;
-				vp.Height = (FLOAT)cur_rt_h;
+				vp.Width = (FLOAT)ctx.cur_rt_w;
+				vp.Height = (FLOAT)ctx.cur_rt_h;
 			}
 			else
 			{
-				vp.Width = (FLOAT)cur_depth_w;
-				vp.Height = (FLOAT)cur_depth_h;
+				vp.Width = (FLOAT)ctx.cur_depth_w;
+				vp.Height = (FLOAT)ctx.cur_depth_h;
 			}
 
 			vp.MinDepth = 0.0f;
 			vp.MaxDepth = 1.0f;
 			vp.TopLeftX = 0;
 			vp.TopLeftY = 0;
-			immediateContext->RSSetViewports(1, &vp);
+
+			ctx.context->RSSetViewports(1, ctx.vp_was_setted ? &ctx.viewport : &vp);
 		}
 
-		if (cur_program)
+		if (ctx.cur_program)
 		{
-			if (need_apply_prog)
+			if (ctx.need_apply_prog)
 			{
-				if (cur_program->vshader) cur_program->vshader->Apply();
-				if (cur_program->pshader) cur_program->pshader->Apply();
+				if (ctx.cur_program->vshader) ctx.cur_program->vshader->Apply();
+				if (ctx.cur_program->pshader) ctx.cur_program->pshader->Apply();
 
 				SetAlphaBlend(false);
 				SetDepthTest(true);
@@ -641,67 +766,75 @@ namespace Oak
 				SetBlendFunc(BlendArg::ArgSrcAlpha, BlendArg::ArgInvSrcAlpha);
 				SetCulling(CullMode::CullCCW);
 
-				cur_program->ApplyStates();
-				need_apply_prog = false;
+				ctx.cur_program->ApplyStates();
+				ctx.need_apply_prog = false;
 			}
 
-			if (cur_program->vshader)
+			if (ctx.cur_program->vshader)
 			{
-				cur_program->vshader->UpdateConstants();
+				ctx.cur_program->vshader->UpdateConstants();
 
-				if (need_apply_vdecl)
+				if (ctx.need_apply_vdecl)
 				{
-					if (cur_vdecl)
+					if (ctx.cur_vdecl)
 					{
-						cur_vdecl->Apply((ShaderDX11*)cur_program->vshader);
+						ctx.cur_vdecl->Apply((ShaderDX11*)ctx.cur_program->vshader);
 					}
 
-					need_apply_vdecl = false;
+					ctx.need_apply_vdecl = false;
 				}
 			}
 
-			if (cur_program->pshader) cur_program->pshader->UpdateConstants();
+			if (ctx.cur_program->pshader) ctx.cur_program->pshader->UpdateConstants();
 		}
 
-		if (blend_changed)
+		if (ctx.blend_changed)
 		{
-			RELEASE(blend_state)
+			RELEASE(ctx.blend_state)
 
-			pd3dDevice->CreateBlendState(blend_desc, &blend_state);
-			immediateContext->OMSetBlendState(blend_state, 0, 0xffffffff);
+			pd3dDevice->CreateBlendState(&ctx.blend_desc, &ctx.blend_state);
+			ctx.context->OMSetBlendState(ctx.blend_state, 0, 0xffffffff);
 
-			blend_changed = false;
+			ctx.blend_changed = false;
 		}
 
-		if (ds_changed)
+		if (ctx.ds_changed)
 		{
-			RELEASE(ds_state)
+			RELEASE(ctx.ds_state)
 
-			instance->pd3dDevice->CreateDepthStencilState(ds_desc, &ds_state);
-			immediateContext->OMSetDepthStencilState(ds_state, 255);
+			pd3dDevice->CreateDepthStencilState(&ctx.ds_desc, &ctx.ds_state);
+			ctx.context->OMSetDepthStencilState(ctx.ds_state, 255);
 
-			ds_changed = false;
+			ctx.ds_changed = false;
 		}
 
-		if (raster_changed)
+		if (ctx.raster_changed)
 		{
-			RELEASE(raster_state)
+			RELEASE(ctx.raster_state)
 
-			pd3dDevice->CreateRasterizerState(raster_desc, &raster_state);
-			immediateContext->RSSetState(raster_state);
+			pd3dDevice->CreateRasterizerState(&ctx.raster_desc, &ctx.raster_state);
+			ctx.context->RSSetState(ctx.raster_state);
 
-			raster_changed = false;
+			ctx.raster_changed = false;
 		}
 	}
 
 	void DeviceDX11::SetScissors(bool enable)
 	{
-		raster_desc->ScissorEnable = enable;
-		raster_changed = true;
+		Context& ctx = GetContext();
+
+		FlushBatch();
+
+		ctx.raster_desc.ScissorEnable = enable;
+		ctx.raster_changed = true;
 	}
 
 	void DeviceDX11::SetScissorRect(Rect rect)
 	{
+		Context& ctx = GetContext();
+
+		FlushBatch();
+
 		RECT DX11Rect;
 
 		DX11Rect.left = rect.left;
@@ -709,11 +842,17 @@ namespace Oak
 		DX11Rect.right = rect.right;
 		DX11Rect.bottom = rect.bottom;
 
-		immediateContext->RSSetScissorRects(1, &DX11Rect);
+		ctx.context->RSSetScissorRects(1, &DX11Rect);
+
+		ctx.scissor_rect = DX11Rect;
 	}
 
 	void DeviceDX11::SetViewport(const Viewport& viewport)
 	{
+		Context& ctx = GetContext();
+
+		FlushBatch();
+
 		D3D11_VIEWPORT vp;
 		vp.Width = (float)viewport.width;
 		vp.Height = (float)viewport.height;
@@ -722,18 +861,19 @@ namespace Oak
 		vp.TopLeftX = (float)viewport.x;
 		vp.TopLeftY = (float)viewport.y;
 
-		immediateContext->RSSetViewports(1, &vp);
+		ctx.context->RSSetViewports(1, &vp);
 
-		vp_was_setted = true;
+		ctx.viewport = vp;
+		ctx.vp_was_setted = true;
 	}
 
 	void DeviceDX11::GetViewport(Viewport& viewport)
 	{
-		if (vp_was_setted)
+		Context& ctx = GetContext();
+
+		if (ctx.vp_was_setted)
 		{
-			D3D11_VIEWPORT d3dviewport;
-			unsigned int num = 1;
-			immediateContext->RSGetViewports(&num, &d3dviewport);
+			D3D11_VIEWPORT& d3dviewport = ctx.viewport;
 
 			viewport.x = (int)d3dviewport.TopLeftX;
 			viewport.y = (int)d3dviewport.TopLeftY;
@@ -747,15 +887,15 @@ namespace Oak
 			viewport.x = 0;
 			viewport.y = 0; 
 
-			if (cur_rt[0])
+			if (ctx.cur_rt[0])
 			{
-				viewport.width = (short)cur_rt_w;
-				viewport.height = (short)cur_rt_h;
+				viewport.width = (short)ctx.cur_rt_w;
+				viewport.height = (short)ctx.cur_rt_h;
 			}
 			else
 			{
-				viewport.width = (short)cur_depth_w;
-				viewport.height = (short)cur_depth_h;
+				viewport.width = (short)ctx.cur_depth_w;
+				viewport.height = (short)ctx.cur_depth_h;
 			}
 
 			viewport.minZ = 0.0f;
@@ -765,7 +905,11 @@ namespace Oak
 
 	void DeviceDX11::SetRenderTarget(int slot, Texture* rt)
 	{
-		vp_was_setted = false;
+		Context& ctx = GetContext();
+
+		FlushBatch();
+
+		ctx.vp_was_setted = false;
 
 		if (rt)
 		{
@@ -778,29 +922,33 @@ namespace Oak
 
 			if (slot == 0)
 			{
-				cur_rt_w = rt_dx11->GetWidth();
-				cur_rt_h = rt_dx11->GetHeight();
+				ctx.cur_rt_w = rt_dx11->GetWidth();
+				ctx.cur_rt_h = rt_dx11->GetHeight();
 			}
 
-			cur_rt[slot] = rt_dx11->rt;
+			ctx.cur_rt[slot] = rt_dx11->rt;
 		}
 		else
 		{
 			if (slot == 0)
 			{
-				cur_rt_w = -1;
-				cur_rt_h = -1;
+				ctx.cur_rt_w = -1;
+				ctx.cur_rt_h = -1;
 			}
 
-			cur_rt[slot] = nullptr;
+			ctx.cur_rt[slot] = nullptr;
 		}
 
-		need_set_rt = true;
+		ctx.need_set_rt = true;
 	}
 
 	void DeviceDX11::SetDepth(Texture* depth)
 	{
-		vp_was_setted = false;
+		Context& ctx = GetContext();
+
+		FlushBatch();
+
+		ctx.vp_was_setted = false;
 
 		if (depth)
 		{
@@ -817,42 +965,177 @@ namespace Oak
 				pd3dDevice->CreateDepthStencilView(depth_dx11->texture, &descDSV, &depth_dx11->depth);
 			}
 
-			cur_depth_w = depth_dx11->GetWidth();
-			cur_depth_h = depth_dx11->GetHeight();
+			ctx.cur_depth_w = depth_dx11->GetWidth();
+			ctx.cur_depth_h = depth_dx11->GetHeight();
 
-			cur_depth = depth_dx11->depth;
+			ctx.cur_depth = depth_dx11->depth;
 		}
 		else
 		{
-			cur_depth_w = -1;
-			cur_depth_h = -1;
-			cur_depth = nullptr;
+			ctx.cur_depth_w = -1;
+			ctx.cur_depth_h = -1;
+			ctx.cur_depth = nullptr;
 		}
 
-		need_set_rt = true;
+		ctx.need_set_rt = true;
 	}
 
 	void DeviceDX11::RestoreRenderTarget()
 	{
-		vp_was_setted = false;
-		cur_rt_w = scr_w;
-		cur_rt_h = scr_h;
+		Context& ctx = GetContext();
+
+		FlushBatch();
+
+		ctx.vp_was_setted = false;
+		ctx.cur_rt_w = scr_w;
+		ctx.cur_rt_h = scr_h;
 	
 		for (int i = 0; i < 6; i++)
 		{
-			cur_rt[i] = nullptr;
+			ctx.cur_rt[i] = nullptr;
+		}
+
+		ctx.cur_rt[0] = renderTargetView;
+		ctx.cur_depth = depthStencilView;
+		ctx.need_set_rt = true;
+	}
+
+	DeviceDX11::Context& DeviceDX11::GetContext()
+	{
+		return contexts[curContext];
+	}
+
+	int DeviceDX11::GetContextIndex()
+	{
+		return curContext;
+	}
+
+	void DeviceDX11::ResetStates(Context& ctx)
+	{
+		for (auto& vbuffer : ctx.cur_vbuffers)
+		{
+			vbuffer = nullptr;
+		}
+
+		ctx.cur_ibuffer = nullptr;
+		ctx.cur_program = nullptr;
+		ctx.cur_vdecl = nullptr;
+		ctx.need_apply_prog = false;
+		ctx.need_apply_vdecl = false;
+		ctx.need_set_rt = true;
+		ctx.blend_changed = true;
+		ctx.ds_changed = true;
+		ctx.raster_changed = true;
+
+		ResetBindings(ctx, false);
+	}
+
+	void DeviceDX11::ResetBindings(Context& ctx, bool onlyViews)
+	{
+		for (int i = 0; i < maxTextures; i++)
+		{
+			ctx.ps_views[i] = nullptr;
+		}
+
+		if (onlyViews)
+		{
+			return;
+		}
+
+		for (int i = 0; i < maxTextures; i++)
+		{
+			ctx.ps_samplers[i] = nullptr;
+		}
+
+		for (int i = 0; i < maxConstantBuffers; i++)
+		{
+			ctx.vs_buffers[i] = nullptr;
+			ctx.ps_buffers[i] = nullptr;
+		}
+	}
+
+	int DeviceDX11::GetCommandListsCount()
+	{
+		return contextsCount - 1;
+	}
+
+	void DeviceDX11::BeginCommandList(int index)
+	{
+		Context& immediate = contexts[0];
+		Context& ctx = contexts[index + 1];
+
+		// deferred context starts from default state, so state of immediate context is copied
+		ctx.blend_desc = immediate.blend_desc;
+		ctx.ds_desc = immediate.ds_desc;
+		ctx.raster_desc = immediate.raster_desc;
+		ctx.vp_was_setted = immediate.vp_was_setted;
+		ctx.viewport = immediate.viewport;
+		ctx.scissor_rect = immediate.scissor_rect;
+
+		for (int i = 0; i < 6; i++)
+		{
+			ctx.cur_rt[i] = immediate.cur_rt[i];
 		}
 
-		cur_rt[0] = renderTargetView;
-		cur_depth = depthStencilView;
-		need_set_rt = true;
+		ctx.cur_depth = immediate.cur_depth;
+		ctx.cur_rt_w = immediate.cur_rt_w;
+		ctx.cur_rt_h = immediate.cur_rt_h;
+		ctx.cur_depth_w = immediate.cur_depth_w;
+		ctx.cur_depth_h = immediate.cur_depth_h;
+
+		ResetStates(ctx);
+
+		ctx.context->RSSetScissorRects(1, &ctx.scissor_rect);
+		ctx.generation++;
+
+		curContext = index + 1;
+	}
+
+	void DeviceDX11::EndCommandList()
+	{
+		Context& ctx = GetContext();
+
+		RELEASE(ctx.commandList)
+		ctx.context->FinishCommandList(FALSE, &ctx.commandList);
+
+		curContext = 0;
+	}
+
+	void DeviceDX11::ExecuteCommandList(int index)
+	{
+		Context& ctx = contexts[index + 1];
+
+		if (!ctx.commandList)
+		{
+			return;
+		}
+
+		FlushBatch();
+
+		immediateContext->ExecuteCommandList(ctx.commandList, TRUE);
+
+		RELEASE(ctx.commandList)
+
+		// constant buffers were overwritten by a command list
+		contexts[0].generation++;
 	}
 
 	void DeviceDX11::Release()
 	{
-		delete blend_desc;
-		delete ds_desc;
-		delete raster_desc;
+		for (int i = 0; i < contextsCount; i++)
+		{
+			Context& ctx = contexts[i];
+
+			RELEASE(ctx.blend_state)
+			RELEASE(ctx.ds_state)
+			RELEASE(ctx.raster_state)
+			RELEASE(ctx.commandList)
+
+			if (i > 0)
+			{
+				RELEASE(ctx.context)
+			}
+		}
 
 		delete this;
 	}
@@ -2,6 +2,7 @@
 #pragma once
 
 #include "Root/Render/Device.h"
+#include "Support/ThreadExecutor.h"
 #include "d3d11.h"
 
 namespace Oak
@@ -14,6 +15,14 @@ namespace Oak
 		friend class TextureDX11;
 		friend class VertexDeclDX11;
 
+	public:
+
+		constexpr static int maxContexts = 8;
+		constexpr static int maxConstantBuffers = D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT;
+		constexpr static int maxTextures = 16;
+
+	private:
+
 		ID3D11Device*             pd3dDevice = nullptr;
 		ID3D11DeviceContext*      immediateContext = nullptr;
 		IDXGISwapChain*           swapChain = nullptr;
@@ -41,30 +50,55 @@ namespace Oak
 
 		eastl::vector<WindowBackBufferHolder> backbuffer_holders;
 
-		D3D11_BLEND_DESC*  blend_desc;
-		ID3D11BlendState*  blend_state;
-		bool                      blend_changed;
-
-		D3D11_DEPTH_STENCIL_DESC* ds_desc;
-		ID3D11DepthStencilState*  ds_state;
-		int                              ds_stencil_ref;
-		bool                             ds_changed;
-
-		D3D11_RASTERIZER_DESC* raster_desc;
-		ID3D11RasterizerState* raster_state;
-		bool                          raster_changed;
-
-		bool vp_was_setted;
-
-		ID3D11RenderTargetView* cur_rt[6];
-		ID3D11DepthStencilView* cur_depth;
-		bool need_set_rt;
-		int  cur_depth_w;
-		int  cur_depth_h;
+		// state of a device context, index 0 is immediate context, others are deferred ones
+		struct Context
+		{
+			ID3D11DeviceContext* context = nullptr;
+			ID3D11CommandList*   commandList = nullptr;
+			int generation = 0;
+
+			D3D11_BLEND_DESC  blend_desc;
+			ID3D11BlendState* blend_state = nullptr;
+			bool              blend_changed = true;
+
+			D3D11_DEPTH_STENCIL_DESC ds_desc;
+			ID3D11DepthStencilState* ds_state = nullptr;
+			bool                     ds_changed = true;
+
+			D3D11_RASTERIZER_DESC  raster_desc;
+			ID3D11RasterizerState* raster_state = nullptr;
+			bool                   raster_changed = true;
+
+			bool vp_was_setted = false;
+			D3D11_VIEWPORT viewport;
+			RECT scissor_rect = { 0, 0, 0, 0 };
+
+			ID3D11RenderTargetView* cur_rt[6] = { nullptr, nullptr, nullptr, nullptr, nullptr, nullptr };
+			ID3D11DepthStencilView* cur_depth = nullptr;
+			bool need_set_rt = true;
+			int  cur_rt_w = 0;
+			int  cur_rt_h = 0;
+			int  cur_depth_w = 0;
+			int  cur_depth_h = 0;
+
+			DataBuffer* cur_vbuffers[4] = { nullptr, nullptr, nullptr, nullptr };
+			DataBuffer* cur_ibuffer = nullptr;
+
+			Program* cur_program = nullptr;
+			bool need_apply_prog = false;
+			class VertexDeclDX11* cur_vdecl = nullptr;
+			bool need_apply_vdecl = false;
+
+			// bound resources, binding is skipped if a slot already holds same resource
+			ID3D11Buffer* vs_buffers[maxConstantBuffers] = {};
+			ID3D11Buffer* ps_buffers[maxConstantBuffers] = {};
+			ID3D11ShaderResourceView* ps_views[maxTextures] = {};
+			ID3D11SamplerState* ps_samplers[maxTextures] = {};
+		};
 
-		bool need_apply_prog = false;
-		class VertexDeclDX11* cur_vdecl = nullptr;
-		bool need_apply_vdecl = false;
+		Context contexts[maxContexts];
+		int contextsCount = 1;
+		CriticalSection resourcesLock;
 
 		DeviceDX11();
 		bool Init(void* external_device) override;
@@ -74,11 +108,17 @@ namespace Oak
 		Shader* CreateShader(ShaderType type, const char* name) override;
 		Texture* CreateTextureInner(int w, int h, TextureFormat f, int l, bool rt, TextureType tp, const char* file, int line);
 		void UpdateStates();
+		void ResetBuffers(DataBuffer* buffer = nullptr);
+		void ResetStates(Context& ctx);
+		void ResetBindings(Context& ctx, bool onlyViews);
 
 	public:
 
 		static DeviceDX11* instance;
 
+		Context& GetContext();
+		int GetContextIndex() override;
+
 		bool SetBackBuffer(int id, int wgt, int hgt, void* data) override;
 		void* GetBackBuffer() override;
 		int GetWidth() override;
@@ -103,6 +143,7 @@ namespace Oak
 		int CalcPrimCount(PrimitiveTopology type, int primCount);
 		void Draw(PrimitiveTopology prim, int startVertex, int primCount) override;
 		void DrawIndexed(PrimitiveTopology prim, int startVertex, int startIndex, int primCount) override;
+		void DrawIndexedInstanced(PrimitiveTopology prim, int startVertex, int startIndex, int primCount, int startInstance, int instanceCount) override;
 
 		void SetAlphaBlend(bool enable) override;
 		void SetBlendFunc(BlendArg src, BlendArg dest) override;
@@ -122,5 +163,10 @@ namespace Oak
 		void SetRenderTarget(int slot, Texture* rt) override;
 		void SetDepth(Texture* depth) override;
 		void RestoreRenderTarget() override;
+
+		int GetCommandListsCount() override;
+		void BeginCommandList(int index) override;
+		void EndCommandList() override;
+		void ExecuteCommandList(int index) override;
 	};
 }
\ No newline at end of file
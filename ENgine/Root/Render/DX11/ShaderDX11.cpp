@@ -3,6 +3,7 @@
 #include "DeviceDX11.h"
 #include "VertexDeclDX11.h"
 #include "TextureDX11.h"
+#include "Root/Root.h"
 
 #include "d3d11.h"
 #include "d3dcompiler.h"
@@ -13,22 +14,30 @@ namespace Oak
 	{
 		char path[1024];
 		StringUtils::Printf(path, 1024, "ENgine/Shaders/PC/%s", name);
-		if (!buffer.Load(path))
+		if (buffer.Load(path))
+		{
+			code = buffer.GetData();
+			codeSize = (size_t)buffer.GetSize();
+		}
+		else
+		if (!Compile(tp, name))
 		{
 			return;
 		}
 
 		if (tp == ShaderType::Vertex)
 		{
-			DeviceDX11::instance->pd3dDevice->CreateVertexShader(buffer.GetData(), buffer.GetSize(), nullptr, &vshader);
+			DeviceDX11::instance->pd3dDevice->CreateVertexShader(code, codeSize, nullptr, &vshader);
 		}
 		else
 		{
-			DeviceDX11::instance->pd3dDevice->CreatePixelShader(buffer.GetData(), buffer.GetSize(), nullptr, &pshader);
+			DeviceDX11::instance->pd3dDevice->CreatePixelShader(code, codeSize, nullptr, &pshader);
 		}
 
+		loaded = (vshader != nullptr || pshader != nullptr);
+
 		ID3D11ShaderReflection* pVertexShaderReflection;
-		D3DReflect(buffer.GetData(), buffer.GetSize(), IID_ID3D11ShaderReflection, (void**)&pVertexShaderReflection);
+		D3DReflect(code, codeSize, IID_ID3D11ShaderReflection, (void**)&pVertexShaderReflection);
 
 		D3D11_SHADER_DESC shaderDesc;
 		pVertexShaderReflection->GetDesc(&shaderDesc);
@@ -47,19 +56,26 @@ namespace Oak
 
 			ConstantBuffer& buffer = buffers.back();
 			buffer.size = shaderBuffer.Size;
-			buffer.rawdata = (byte*)malloc(buffer.size);
+			buffer.rawdata = (byte*)malloc(buffer.size * DeviceDX11::maxContexts);
+			memset(buffer.rawdata, 0, buffer.size * DeviceDX11::maxContexts);
 
 			buffer.slot = bindingDesc.BindPoint;
 
 			D3D11_BUFFER_DESC bd;
 			ZeroMemory(&bd, sizeof(bd));
 
-			bd.Usage = D3D11_USAGE_DEFAULT;
+			bd.Usage = D3D11_USAGE_DYNAMIC;
 			bd.ByteWidth = buffer.size;
 			bd.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
-			bd.CPUAccessFlags = 0;
+			bd.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
 			DeviceDX11::instance->pd3dDevice->CreateBuffer(&bd, nullptr, &buffer.buffer);
 
+			// content of dynamic buffer is undefined until first upload
+			for (auto& generation : buffer.generation)
+			{
+				generation = -1;
+			}
+
 			for (unsigned int j = 0; j < shaderBuffer.Variables; j++)
 			{
 				ID3D11ShaderReflectionVariable * pVariable = pConstBuffer->GetVariableByIndex(j);
@@ -72,8 +88,10 @@ namespace Oak
 
 				pType->GetDesc(&varType);
 
-				ShaderParamInfo& param = constantsInfo[varDesc.Name];
+				paramsSearch[varDesc.Name] = (int)params.size();
+				params.push_back(ShaderParamInfo());
 
+				ShaderParamInfo& param = params.back();
 				param.slot = i;
 				param.offset = varDesc.StartOffset;
 				param.size = varDesc.Size;
@@ -87,126 +105,217 @@ namespace Oak
 
 			if (bindDesc.Type == D3D_SIT_TEXTURE)
 			{
-				ShaderParamInfo& param = samplersInfo[bindDesc.Name];
+				paramsSearch[bindDesc.Name] = (int)params.size();
+				params.push_back(ShaderParamInfo());
 
+				ShaderParamInfo& param = params.back();
 				param.slot = bindDesc.BindPoint;
+				param.texture = true;
+
+				textureSlots.push_back(param.slot);
 			}
 		}
 
-		for (int i = 0; i < 16; i++)
+		memset(textures, 0, sizeof(textures));
+	}
+
+	bool ShaderDX11::Compile(ShaderType tp, const char* name)
+	{
+		// precompiled shader is missing, so source "name.shader" of a pair "name_vs.shd" and "name_ps.shd" is compiled
+		char sourceName[512];
+		StringUtils::Copy(sourceName, 512, name);
+
+		int len = (int)strlen(sourceName);
+		const char* suffix = (tp == ShaderType::Vertex) ? "_vs.shd" : "_ps.shd";
+		int suffixLen = (int)strlen(suffix);
+
+		if (len < suffixLen || !StringUtils::IsEqual(&sourceName[len - suffixLen], suffix))
 		{
-			textures[i] = nullptr;
+			return false;
 		}
+
+		StringUtils::Copy(&sourceName[len - suffixLen], 512 - len + suffixLen, ".shader");
+
+		char path[1024];
+		StringUtils::Printf(path, 1024, "ENgine/Shaders/PC/%s", sourceName);
+
+		FileInMemory source;
+
+		if (!source.Load(path))
+		{
+			return false;
+		}
+
+		ID3D10Blob* errors = nullptr;
+
+		HRESULT hr = D3DCompile(source.GetData(), source.GetSize(), sourceName, nullptr, nullptr,
+		                        (tp == ShaderType::Vertex) ? "VS" : "PS", (tp == ShaderType::Vertex) ? "vs_4_0" : "ps_4_0",
+		                        D3DCOMPILE_OPTIMIZATION_LEVEL3, 0, &compiled, &errors);
+
+		if (FAILED(hr))
+		{
+			root.Log("Render", "Shader %s wasn't compiled: %s", sourceName, errors ? (const char*)errors->GetBufferPointer() : "");
+		}
+
+		RELEASE(errors);
+
+		if (FAILED(hr))
+		{
+			return false;
+		}
+
+		code = compiled->GetBufferPointer();
+		codeSize = compiled->GetBufferSize();
+
+		return true;
 	}
 
-	bool ShaderDX11::SetVector(const char* param, Math::Vector4* v, int count)
+	int ShaderDX11::GetParam(const char* param)
 	{
-		ShaderParamInfo& spInfo = constantsInfo[param];
+		auto iter = paramsSearch.find_as(param, eastl::less_2<eastl::string, const char*>());
+
+		if (iter == paramsSearch.end())
+		{
+			return -1;
+		}
+
+		return iter->second;
+	}
 
-		if (spInfo.slot == -1)
+	bool ShaderDX11::SetVector(int param, Math::Vector4* v, int count)
+	{
+		if (param < 0 || param >= (int)params.size() || params[param].texture)
 		{
 			return false;
 		}
 
+		ShaderParamInfo& spInfo = params[param];
+
 		ConstantBuffer* buffer = &buffers[spInfo.slot];
+		int context = DeviceDX11::instance->GetContextIndex();
 
 		int sz = min(spInfo.size, sizeof(float) * 4 * count);
-		memcpy((void*)&buffer->rawdata[spInfo.offset], &v->x, sz);
+		memcpy((void*)&buffer->rawdata[context * buffer->size + spInfo.offset], &v->x, sz);
 
-		buffer->dirty = true;
+		buffer->dirty[context] = true;
 
 		return true;
 	}
 
-	bool ShaderDX11::SetMatrix(const char* param, Math::Matrix* m, int count)
+	bool ShaderDX11::SetMatrix(int param, Math::Matrix* m, int count)
 	{
-		ShaderParamInfo& spInfo = constantsInfo[param];
-
-		if (spInfo.slot == -1)
+		if (param < 0 || param >= (int)params.size() || params[param].texture)
 		{
 			return false;
 		}
 
+		ShaderParamInfo& spInfo = params[param];
+
 		ConstantBuffer* buffer = &buffers[spInfo.slot];
+		int context = DeviceDX11::instance->GetContextIndex();
 
 		Math::Matrix tmp;
 		memcpy(&tmp.matrix[0], &m->matrix[0], 64);
 	
 		tmp.Transpose();
 
-		memcpy((void*)&buffer->rawdata[spInfo.offset], &tmp.matrix[0], spInfo.size);
+		memcpy((void*)&buffer->rawdata[context * buffer->size + spInfo.offset], &tmp.matrix[0], spInfo.size);
 
-		buffer->dirty = true;
+		buffer->dirty[context] = true;
 
 		return true;
 	}
 
-	bool ShaderDX11::SetTexture(const char* param, Texture* tex)
+	bool ShaderDX11::SetTexture(int param, Texture* tex)
 	{
-		ShaderParamInfo& spInfo = samplersInfo[param];
-
-		if (spInfo.slot == -1)
+		if (param < 0 || param >= (int)params.size() || !params[param].texture)
 		{
 			return false;
 		}
 
-		textures[spInfo.slot] = (TextureDX11*)tex;
+		ShaderParamInfo& spInfo = params[param];
+
+		textures[DeviceDX11::instance->GetContextIndex()][spInfo.slot] = (TextureDX11*)tex;
 
 		return true;
 	}
 
 	void ShaderDX11::Apply()
 	{
+		auto* context = DeviceDX11::instance->GetContext().context;
+
 		if (shaderType == ShaderType::Vertex)
 		{
-			DeviceDX11::instance->immediateContext->VSSetShader(vshader, 0, 0);
+			context->VSSetShader(vshader, 0, 0);
 		}
 		else
 		{
-			DeviceDX11::instance->immediateContext->PSSetShader(pshader, 0, 0);
+			context->PSSetShader(pshader, 0, 0);
 		}
 	}
 
 	void ShaderDX11::UpdateConstants()
 	{
+		auto& ctx = DeviceDX11::instance->GetContext();
+		int context = DeviceDX11::instance->GetContextIndex();
+
 		for (int i = 0; i<buffers.size(); i++)
 		{
 			ConstantBuffer* buffer = &buffers[i];
 
-			if (buffer->dirty)
+			// buffer is shared between contexts, so it is uploaded again after other context wrote into it
+			if (buffer->dirty[context] || buffer->generation[context] != ctx.generation)
 			{
-				DeviceDX11::instance->immediateContext->UpdateSubresource(buffer->buffer, 0, nullptr, buffer->rawdata, 0, 0);
+				D3D11_MAPPED_SUBRESOURCE res;
+
+				if (ctx.context->Map(buffer->buffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &res) >= 0)
+				{
+					memcpy(res.pData, &buffer->rawdata[context * buffer->size], buffer->size);
+					ctx.context->Unmap(buffer->buffer, 0);
+				}
+
+				buffer->dirty[context] = false;
+				buffer->generation[context] = ctx.generation;
+			}
 
-				buffer->dirty = false;
+			if (i >= DeviceDX11::maxConstantBuffers)
+			{
+				continue;
 			}
 
 			if (shaderType == ShaderType::Pixel)
 			{
-				DeviceDX11::instance->immediateContext->PSSetConstantBuffers(i, 1, &buffer->buffer);
+				if (ctx.ps_buffers[i] != buffer->buffer)
+				{
+					ctx.context->PSSetConstantBuffers(i, 1, &buffer->buffer);
+					ctx.ps_buffers[i] = buffer->buffer;
+				}
 			}
 			else
 			{
-				DeviceDX11::instance->immediateContext->VSSetConstantBuffers(i, 1, &buffer->buffer);
+				if (ctx.vs_buffers[i] != buffer->buffer)
+				{
+					ctx.context->VSSetConstantBuffers(i, 1, &buffer->buffer);
+					ctx.vs_buffers[i] = buffer->buffer;
+				}
 			}
 		}
 
-		typedef eastl::map<eastl::string, ShaderParamInfo>::iterator it_type;
-
-		for (it_type iterator = samplersInfo.begin(); iterator != samplersInfo.end(); iterator++)
+		for (int slot : textureSlots)
 		{
-			ShaderParamInfo& spInfo = iterator->second;
+			TextureDX11* texture = textures[context][slot];
 
-			if (spInfo.slot == -1)
+			if (texture)
 			{
-				continue;
-			}
+				ID3D11ShaderResourceView* sh_view = (ID3D11ShaderResourceView*)texture->srview;
 
-			if (textures[spInfo.slot])
-			{
-				ID3D11ShaderResourceView* sh_view = (ID3D11ShaderResourceView*)textures[spInfo.slot]->srview;
+				texture->Apply(slot);
 
-				textures[spInfo.slot]->Apply(spInfo.slot);
-				DeviceDX11::instance->immediateContext->PSSetShaderResources(spInfo.slot, 1, &sh_view);
+				if (ctx.ps_views[slot] != sh_view)
+				{
+					ctx.context->PSSetShaderResources(slot, 1, &sh_view);
+					ctx.ps_views[slot] = sh_view;
+				}
 			}
 		}
 	}
@@ -215,6 +324,7 @@ namespace Oak
 	{
 		RELEASE(vshader);
 		RELEASE(pshader);
+		RELEASE(compiled);
 
 		delete this;
 	}
@@ -2,6 +2,7 @@
 #pragma once
 
 #include "Root/Render/Shader.h"
+#include "DeviceDX11.h"
 #include "Root/Files/FileInMemory.h"
 #include <eastl/vector.h>
 #include <eastl/map.h>
@@ -10,6 +11,7 @@
 struct ID3D11VertexShader;
 struct ID3D11PixelShader;
 struct ID3D11Buffer;
+struct ID3D10Blob;
 
 namespace Oak
 {
@@ -17,15 +19,17 @@ namespace Oak
 	{
 		friend class VertexDeclDX11;
 
-		ID3D11VertexShader* vshader;
-		ID3D11PixelShader*  pshader;
+		ID3D11VertexShader* vshader = nullptr;
+		ID3D11PixelShader*  pshader = nullptr;
 
+		// each context of a device has own copy of data
 		struct ConstantBuffer
 		{
 			uint8_t* rawdata = nullptr;
 			int      size = 0;
 			int      slot = 0;
-			bool     dirty = false;
+			bool     dirty[DeviceDX11::maxContexts] = {};
+			int      generation[DeviceDX11::maxContexts] = {};
 			ID3D11Buffer* buffer = nullptr;
 		};
 
@@ -34,23 +38,31 @@ namespace Oak
 			int slot = -1;
 			int offset = 0;
 			int size = 0;
+			bool texture = false;
 		};
 
 		eastl::vector<ConstantBuffer> buffers;
-		eastl::map<eastl::string, ShaderParamInfo> constantsInfo;
-		eastl::map<eastl::string, ShaderParamInfo> samplersInfo;
+		eastl::vector<ShaderParamInfo> params;
+		eastl::vector<int> textureSlots;
+		eastl::map<eastl::string, int> paramsSearch;
 
 		FileInMemory buffer;
-		class TextureDX11* textures[16];
+		ID3D10Blob* compiled = nullptr;
+		const void* code = nullptr;
+		size_t codeSize = 0;
+
+		class TextureDX11* textures[DeviceDX11::maxContexts][DeviceDX11::maxTextures];
+		bool Compile(ShaderType tp, const char* name);
 		virtual void Release();
 
 	public:
 
 		ShaderDX11(ShaderType tp, const char* name);
 
-		virtual bool SetVector(const char* param, Math::Vector4* v, int count);
-		virtual bool SetMatrix(const char* param, Math::Matrix* m, int count);
-		virtual bool SetTexture(const char* param, Texture* tex);
+		virtual int GetParam(const char* param);
+		virtual bool SetVector(int param, Math::Vector4* v, int count);
+		virtual bool SetMatrix(int param, Math::Matrix* m, int count);
+		virtual bool SetTexture(int param, Texture* tex);
 
 		virtual void Apply();
 		virtual void UpdateConstants();
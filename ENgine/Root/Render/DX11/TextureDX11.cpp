@@ -142,47 +142,61 @@ namespace Oak
 	{
 		if (sampler_need_recrete)
 		{
-			RELEASE(sampler)
+			// texture could be applied from several contexts at once
+			DeviceDX11::instance->resourcesLock.Enter();
 
-			D3D11_SAMPLER_DESC sampDesc;
-			ZeroMemory( &sampDesc, sizeof(sampDesc) );
-
-			D3D11_FILTER filter = D3D11_FILTER_MIN_MAG_MIP_POINT;
-
-			if (magminf == TextureFilter::Point && mipmapf == TextureFilter::Point)
-			{
-				filter = D3D11_FILTER_MIN_MAG_MIP_POINT;
-			}
-			else
-			if (magminf == TextureFilter::Point && mipmapf == TextureFilter::Linear)
-			{
-				filter = D3D11_FILTER_MIN_MAG_POINT_MIP_LINEAR;
-			}
-			else
-			if (magminf == TextureFilter::Linear && mipmapf == TextureFilter::Point)
+			if (sampler_need_recrete)
 			{
-				filter = D3D11_FILTER_MIN_MAG_LINEAR_MIP_POINT;
-			}
-			else
-			if (magminf == TextureFilter::Linear && mipmapf == TextureFilter::Linear)
-			{
-				filter = D3D11_FILTER_MIN_MAG_MIP_LINEAR;
+				RELEASE(sampler)
+
+				D3D11_SAMPLER_DESC sampDesc;
+				ZeroMemory( &sampDesc, sizeof(sampDesc) );
+
+				D3D11_FILTER filter = D3D11_FILTER_MIN_MAG_MIP_POINT;
+
+				if (magminf == TextureFilter::Point && mipmapf == TextureFilter::Point)
+				{
+					filter = D3D11_FILTER_MIN_MAG_MIP_POINT;
+				}
+				else
+				if (magminf == TextureFilter::Point && mipmapf == TextureFilter::Linear)
+				{
+					filter = D3D11_FILTER_MIN_MAG_POINT_MIP_LINEAR;
+				}
+				else
+				if (magminf == TextureFilter::Linear && mipmapf == TextureFilter::Point)
+				{
+					filter = D3D11_FILTER_MIN_MAG_LINEAR_MIP_POINT;
+				}
+				else
+				if (magminf == TextureFilter::Linear && mipmapf == TextureFilter::Linear)
+				{
+					filter = D3D11_FILTER_MIN_MAG_MIP_LINEAR;
+				}
+
+				sampDesc.Filter = filter;
+				sampDesc.AddressU = (D3D11_TEXTURE_ADDRESS_MODE)((int)adressU + 1);
+				sampDesc.AddressV = (D3D11_TEXTURE_ADDRESS_MODE)((int)adressV + 1);
+				sampDesc.AddressW = (D3D11_TEXTURE_ADDRESS_MODE)((int)adressW + 1);
+				sampDesc.ComparisonFunc = D3D11_COMPARISON_ALWAYS;
+				sampDesc.MinLOD = 0;
+				sampDesc.MaxLOD = D3D11_FLOAT32_MAX;
+
+				DeviceDX11::instance->pd3dDevice->CreateSamplerState( &sampDesc, &sampler );
+
+				sampler_need_recrete = false;
 			}
 
-			sampDesc.Filter = filter;
-			sampDesc.AddressU = (D3D11_TEXTURE_ADDRESS_MODE)((int)adressU + 1);
-			sampDesc.AddressV = (D3D11_TEXTURE_ADDRESS_MODE)((int)adressV + 1);
-			sampDesc.AddressW = (D3D11_TEXTURE_ADDRESS_MODE)((int)adressW + 1);
-			sampDesc.ComparisonFunc = D3D11_COMPARISON_ALWAYS;
-			sampDesc.MinLOD = 0;
-			sampDesc.MaxLOD = D3D11_FLOAT32_MAX;
+			DeviceDX11::instance->resourcesLock.UnLock();
+		}
 
-			DeviceDX11::instance->pd3dDevice->CreateSamplerState( &sampDesc, &sampler );
+		auto& ctx = DeviceDX11::instance->GetContext();
 
-			sampler_need_recrete = false;
+		if (ctx.ps_samplers[slot] != sampler)
+		{
+			ctx.context->PSSetSamplers( slot, 1, &sampler );
+			ctx.ps_samplers[slot] = sampler;
 		}
-
-		DeviceDX11::instance->immediateContext->PSSetSamplers( slot, 1, &sampler );
 	}
 
 	void TextureDX11::Update(int level, int layer, uint8_t* data, int stride)
@@ -6,7 +6,8 @@ namespace Oak
 {
 	VertexDeclDX11::VertexDeclDX11(int count, VertexDecl::ElemDesc* elems)
 	{
-		int offset = 0;
+		// per vertex and per instance elements are packed into separate buffers
+		int offset[] = { 0, 0 };
 
 		DXGI_FORMAT formats[] = { DXGI_FORMAT_R32_FLOAT, DXGI_FORMAT_R32G32_FLOAT, DXGI_FORMAT_R32G32B32_FLOAT, DXGI_FORMAT_R32G32B32A32_FLOAT,
 								  DXGI_FORMAT_R32_SINT, DXGI_FORMAT_R32G32_SINT, DXGI_FORMAT_R32G32B32_SINT, DXGI_FORMAT_R32G32B32A32_SINT,
@@ -34,15 +35,17 @@ namespace Oak
 					break;
 			}
 
+			int slot = elems[i].instanced ? 1 : 0;
+
 			elementDesc.SemanticIndex = elems[i].index;
-			elementDesc.InputSlot = 0;
-			elementDesc.AlignedByteOffset = offset;
-			elementDesc.InputSlotClass = D3D11_INPUT_PER_VERTEX_DATA;
-			elementDesc.InstanceDataStepRate = 0;
+			elementDesc.InputSlot = slot;
+			elementDesc.AlignedByteOffset = offset[slot];
+			elementDesc.InputSlotClass = elems[i].instanced ? D3D11_INPUT_PER_INSTANCE_DATA : D3D11_INPUT_PER_VERTEX_DATA;
+			elementDesc.InstanceDataStepRate = elems[i].instanced ? 1 : 0;
 
 			int index = (int)elems[i].type;
 			elementDesc.Format = formats[index];
-			offset += offsets[index];
+			offset[slot] += offsets[index];
 		}
 	}
 
@@ -50,20 +53,27 @@ namespace Oak
 	{
 		ID3D11InputLayout* layout = nullptr;
 
-		if (layouts.count(shader) == 0)
+		// declaration could be applied from several contexts at once
+		DeviceDX11::instance->resourcesLock.Enter();
+
+		auto iter = layouts.find(shader);
+
+		if (iter == layouts.end())
 		{
-			DeviceDX11::instance->pd3dDevice->CreateInputLayout(&layoutDesc[0], (UINT)layoutDesc.size(), shader->buffer.GetData(), (size_t)shader->buffer.GetSize(), &layout);
+			DeviceDX11::instance->pd3dDevice->CreateInputLayout(&layoutDesc[0], (UINT)layoutDesc.size(), shader->code, shader->codeSize, &layout);
 
 			layouts[shader] = layout;
 		}
 		else
 		{
-			layout = layouts[shader];
+			layout = iter->second;
 		}
 
+		DeviceDX11::instance->resourcesLock.UnLock();
+
 		if (layout)
 		{
-			DeviceDX11::instance->immediateContext->IASetInputLayout(layout);
+			DeviceDX11::instance->GetContext().context->IASetInputLayout(layout);
 		}
 	}
 
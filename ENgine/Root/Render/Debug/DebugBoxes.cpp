@@ -82,6 +82,8 @@ namespace Oak
 		ibuffer->Unlock();
 
 		prg = root.render.GetProgram("DbgTriangle", _FL_);
+		transParam = prg->GetParam(ShaderType::Vertex, "trans");
+		colorParam = prg->GetParam(ShaderType::Pixel, "color");
 
 		debugTaskPool->AddTask(199, this, (Object::Delegate)&DebugBoxes::Draw);
 	}
@@ -129,8 +131,8 @@ namespace Oak
 		{
 			Box& box = boxes[i];
 
-			prg->SetMatrix(ShaderType::Vertex, "trans", &box.trans, 1);
-			prg->SetVector(ShaderType::Pixel, "color", (Math::Vector4*)&box.color, 1);
+			prg->SetMatrix(transParam, &box.trans, 1);
+			prg->SetVector(colorParam, (Math::Vector4*)&box.color, 1);
 
 			root.render.GetDevice()->DrawIndexed(PrimitiveTopology::TrianglesList, 0, 0, 12);
 		}
@@ -23,6 +23,8 @@ namespace Oak
 		eastl::vector<Box> boxes;
 
 		ProgramRef prg;
+		Program::Param transParam;
+		Program::Param colorParam;
 		DataBufferRef vbuffer;
 		VertexDeclRef vdecl;
 		DataBufferRef ibuffer;
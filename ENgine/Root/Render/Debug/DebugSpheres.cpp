@@ -67,6 +67,8 @@ namespace Oak
 		ibuffer->Unlock();
 
 		prg = root.render.GetProgram("DbgTriangle", _FL_);
+		transParam = prg->GetParam(ShaderType::Vertex, "trans");
+		colorParam = prg->GetParam(ShaderType::Pixel, "color");
 
 		debugTaskPool->AddTask(199, this, (Object::Delegate)&DebugSpheres::Draw);
 	}
@@ -118,8 +120,8 @@ namespace Oak
 			mat.Scale(scale);
 			mat.Pos() = sphere.pos;
 
-			prg->SetMatrix(ShaderType::Vertex, "trans", &mat, 1);
-			prg->SetVector(ShaderType::Pixel, "color", (Math::Vector4*)&sphere.color, 1);
+			prg->SetMatrix(transParam, &mat, 1);
+			prg->SetVector(colorParam, (Math::Vector4*)&sphere.color, 1);
 
 			root.render.GetDevice()->DrawIndexed(PrimitiveTopology::TrianglesList, 0, 0, PrimCount);
 		}
@@ -31,6 +31,8 @@ namespace Oak
 		eastl::vector<Sphere> spheres;
 
 		ProgramRef prg;
+		Program::Param transParam;
+		Program::Param colorParam;
 		VertexDeclRef vdecl;
 		DataBufferRef vbuffer;
 		DataBufferRef ibuffer;
@@ -42,6 +42,9 @@ namespace Oak
 		vbuffer->Unlock();
 
 		prg = root.render.GetProgram("DbgSprite", _FL_);
+		descParam = prg->GetParam(ShaderType::Vertex, "desc");
+		colorParam = prg->GetParam(ShaderType::Pixel, "color");
+		diffuseMapParam = prg->GetParam(ShaderType::Pixel, "diffuseMap");
 	}
 
 	void DebugSprites::AddSprite(Texture* texture, Math::Vector2 pos, Math::Vector2 size, Math::Vector2 offset, float angle, Color color)
@@ -79,13 +82,13 @@ namespace Oak
 
 		for (auto& sprite : sprites)
 		{
-			prg->SetTexture(ShaderType::Pixel, "diffuseMap", sprite.texture ? sprite.texture : root.render.GetWhiteTexture());
-			prg->SetVector(ShaderType::Pixel, "color", (Math::Vector4*)&sprite.color.r, 1);
+			prg->SetTexture(diffuseMapParam, sprite.texture ? sprite.texture : root.render.GetWhiteTexture());
+			prg->SetVector(colorParam, (Math::Vector4*)&sprite.color.r, 1);
 
 			params[1] = Math::Vector4(sprite.pos.x, sprite.pos.y, sprite.size.x, sprite.size.y);
 			params[2] = Math::Vector4(sprite.offset.x, sprite.offset.y, sprite.angle, 0.0f);
 
-			prg->SetVector(ShaderType::Vertex, "desc", params, 3);
+			prg->SetVector(descParam, params, 3);
 
 			root.render.GetDevice()->Draw(PrimitiveTopology::TriangleStrip, 0, 2);
 		}
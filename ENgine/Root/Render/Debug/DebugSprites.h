@@ -14,6 +14,9 @@ namespace Oak
 		};
 
 		ProgramRef prg;
+		Program::Param descParam;
+		Program::Param colorParam;
+		Program::Param diffuseMapParam;
 		VertexDeclRef vdecl;
 		DataBufferRef vbuffer;
 
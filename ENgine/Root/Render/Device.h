@@ -94,9 +94,11 @@ namespace Oak
 	class Device
 	{
 		friend class Render;
+		friend class CommandBuffer;
 		friend class Program;
 		friend class DeviceDX11;
 		friend class DeviceGLES;
+		friend class DeviceNull;
 
 		#ifndef DOXYGEN_SKIP
 
@@ -112,6 +114,9 @@ namespace Oak
 
 		Program* cur_program = nullptr;
 
+		void (*batchFlusher)() = nullptr;
+		bool batchPending = false;
+
 		#endif
 
 	public:
@@ -273,6 +278,19 @@ namespace Oak
 		*/
 		virtual void DrawIndexed(PrimitiveTopology prim, int startVertex, int startIndex, int primCount) = 0;
 
+		/**
+		\brief Draw several instances of indexed primitives. Per instance data is taken from a buffer in slot 1.
+
+		\param[in] prim Primitives type
+		\param[in] startVertex Index of start vertex
+		\param[in] startIndex Index of start index
+		\param[in] primCount Count of primitives
+		\param[in] startInstance Index of first instance in a buffer in slot 1
+		\param[in] instanceCount Count of instances
+
+		*/
+		virtual void DrawIndexedInstanced(PrimitiveTopology prim, int startVertex, int startIndex, int primCount, int startInstance, int instanceCount) = 0;
+
 		/**
 		\brief Controls alpha blending
 
@@ -382,10 +400,68 @@ namespace Oak
 		*/
 		virtual void RestoreRenderTarget() = 0;
 
+		/**
+		\brief Get number of command lists which can be recorded on other threads
+
+		\return Number of command lists. Zero means that device doesn't support deferred recording
+		*/
+		virtual int GetCommandListsCount() { return 0; };
+
+		/**
+		\brief Start recording of a command list. All calls of a device from a calling thread are recorded
+		into a list until EndCommandList. Recording starts with render target, viewport and render states
+		which were set on the main thread, but without program and bound buffers.
+
+		\param[in] index Index of a command list
+		*/
+		virtual void BeginCommandList(int index) {};
+
+		/**
+		\brief Finish recording of a command list which was started by a calling thread
+		*/
+		virtual void EndCommandList() {};
+
+		/**
+		\brief Get index of a context which is used by a calling thread
+
+		\return Index of a context. Zero means immediate context, other values are command lists recorded on other threads
+		*/
+		virtual int GetContextIndex() { return 0; };
+
+		/**
+		\brief Execute recorded command list. Should be called from a thread which owns a device.
+
+		\param[in] index Index of a command list
+		*/
+		virtual void ExecuteCommandList(int index) {};
+
+		/**
+		\brief Set callback which draws batched geometry. Callback is called before any change of a state,
+		draw call or present if some geometry was marked as pending via MarkBatchPending.
+
+		\param[in] flusher Pointer to a callback
+		*/
+		void SetBatchFlusher(void (*flusher)()) { batchFlusher = flusher; };
+
+		/**
+		\brief Mark that batched geometry is waiting to be drawn
+		*/
+		void MarkBatchPending() { batchPending = (batchFlusher != nullptr); };
+
 	protected:
 
 		#ifndef DOXYGEN_SKIP
 
+		void FlushBatch()
+		{
+			// batched geometry is shared between threads, so it is drawn only via immediate context
+			if (batchPending && GetContextIndex() == 0)
+			{
+				batchPending = false;
+				batchFlusher();
+			}
+		};
+
 		virtual Shader* CreateShader(ShaderType type, const char* name) = 0;
 		virtual Texture* CreateTextureInner(int w, int h, TextureFormat f, int l, bool rt, TextureType tp, const char* file, int line) = 0;
 
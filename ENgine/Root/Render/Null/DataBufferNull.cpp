@@ -0,0 +1,32 @@
+
+#include "DataBufferNull.h"
+#include "DeviceNull.h"
+#include "Root/Root.h"
+
+namespace Oak
+{
+	DataBufferNull::DataBufferNull(int sz, int strd) : DataBuffer(sz, strd)
+	{
+		data = NEW uint8_t[size];
+	}
+
+	void* DataBufferNull::Lock()
+	{
+		return data;
+	}
+
+	void DataBufferNull::Unlock()
+	{
+		DeviceNull::instance->GetContext().stats.bufferUploads++;
+		DeviceNull::instance->GetContext().stats.bufferBytes += size;
+	}
+
+	void DataBufferNull::Release()
+	{
+		DeviceNull::instance->ResetBuffers(this);
+
+		delete[] data;
+
+		delete this;
+	}
+}
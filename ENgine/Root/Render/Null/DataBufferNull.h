@@ -0,0 +1,20 @@
+#pragma once
+
+#include "Root/Render/DataBuffer.h"
+#include <stdint.h>
+
+namespace Oak
+{
+	class DataBufferNull : public DataBuffer
+	{
+		virtual void Release();
+	public:
+
+		uint8_t* data = nullptr;
+
+		DataBufferNull(int sz, int strd);
+
+		virtual void* Lock();
+		virtual void Unlock();
+	};
+}
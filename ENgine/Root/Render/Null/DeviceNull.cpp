@@ -0,0 +1,493 @@
+
+#include "DeviceNull.h"
+#include "DataBufferNull.h"
+#include "ShaderNull.h"
+#include "VertexDeclNull.h"
+#include "TextureNull.h"
+#include "Root/Root.h"
+
+namespace Oak
+{
+	DeviceNull* DeviceNull::instance = nullptr;
+
+	static thread_local int curContext = 0;
+
+	DeviceNull::DeviceNull()
+	{
+		instance = this;
+	}
+
+	bool DeviceNull::Init(void* external_device)
+	{
+		root.Log("Render", "Null device is used, nothing will be presented");
+
+		return true;
+	}
+
+	const DeviceNull::Stats& DeviceNull::GetStats()
+	{
+		return contexts[0].stats;
+	}
+
+	void DeviceNull::ResetStats()
+	{
+		contexts[0].stats = Stats();
+	}
+
+	void DeviceNull::SetValidation(bool enable)
+	{
+		validation = enable;
+	}
+
+	bool DeviceNull::SetBackBuffer(int id, int wgt, int hgt, void* data)
+	{
+		scr_w = wgt;
+		scr_h = hgt;
+		cur_aspect = (float)hgt / (float)wgt;
+
+		RestoreRenderTarget();
+
+		return true;
+	}
+
+	int DeviceNull::GetWidth()
+	{
+		return scr_w;
+	}
+
+	int DeviceNull::GetHeight()
+	{
+		return scr_h;
+	}
+
+	float DeviceNull::GetAspect()
+	{
+		return cur_aspect;
+	}
+
+	void DeviceNull::Clear(bool renderTarget, Color color, bool zbuffer, float zValue)
+	{
+		FlushBatch();
+	}
+
+	void DeviceNull::Present()
+	{
+		Context& ctx = GetContext();
+
+		FlushBatch();
+
+		ctx.stats.frames++;
+	}
+
+	void DeviceNull::PrepareProgram(Program* program)
+	{
+
+	}
+
+	void DeviceNull::SetProgram(Program* program)
+	{
+		Context& ctx = GetContext();
+
+		FlushBatch();
+
+		if (ctx.cur_program != program)
+		{
+			ctx.cur_program = program;
+			ctx.stats.programChanges++;
+
+			if (ctx.cur_program)
+			{
+				SetAlphaBlend(false);
+				SetDepthTest(true);
+				SetDepthWriting(true);
+				SetBlendFunc(BlendArg::ArgSrcAlpha, BlendArg::ArgInvSrcAlpha);
+				SetCulling(CullMode::CullCCW);
+
+				ctx.cur_program->ApplyStates();
+			}
+		}
+	}
+
+	VertexDeclRef DeviceNull::CreateVertexDecl(int count, VertexDecl::ElemDesc* elems, const char* file, int line)
+	{
+		return VertexDeclRef(new(file, line) VertexDeclNull(count, elems), file, line);
+	}
+
+	void DeviceNull::SetVertexDecl(VertexDecl* vdecl)
+	{
+		Context& ctx = GetContext();
+
+		FlushBatch();
+
+		if (ctx.cur_vdecl != vdecl)
+		{
+			ctx.cur_vdecl = vdecl;
+			ctx.stats.vdeclChanges++;
+		}
+	}
+
+	DataBufferRef DeviceNull::CreateBuffer(int count, int stride, const char* file, int line)
+	{
+		return DataBufferRef(new(file, line) DataBufferNull(count, stride), file, line);
+	}
+
+	void DeviceNull::ResetBuffers(DataBuffer* buffer)
+	{
+		for (auto& ctx : contexts)
+		{
+			for (auto& vbuffer : ctx.cur_vbuffers)
+			{
+				if (vbuffer == buffer)
+				{
+					vbuffer = nullptr;
+				}
+			}
+
+			if (ctx.cur_ibuffer == buffer)
+			{
+				ctx.cur_ibuffer = nullptr;
+			}
+		}
+	}
+
+	void DeviceNull::SetVertexBuffer(int slot, DataBuffer* buffer)
+	{
+		Context& ctx = GetContext();
+
+		FlushBatch();
+
+		if (slot < 4 && ctx.cur_vbuffers[slot] != buffer)
+		{
+			ctx.cur_vbuffers[slot] = buffer;
+			ctx.stats.bufferChanges++;
+		}
+	}
+
+	void DeviceNull::SetIndexBuffer(DataBuffer* buffer)
+	{
+		Context& ctx = GetContext();
+
+		FlushBatch();
+
+		if (ctx.cur_ibuffer != buffer)
+		{
+			ctx.cur_ibuffer = buffer;
+			ctx.stats.bufferChanges++;
+		}
+	}
+
+	Shader* DeviceNull::CreateShader(ShaderType type, const char* name)
+	{
+		return NEW ShaderNull(type);
+	}
+
+	Texture* DeviceNull::CreateTextureInner(int w, int h, TextureFormat f, int l, bool rt, TextureType tp, const char* file, int line)
+	{
+		return new(file, line) TextureNull(w, h, f, l, tp);
+	}
+
+	TextureRef DeviceNull::CreateTexture(int w, int h, TextureFormat f, int l, bool rt, TextureType tp, const char* file, int line)
+	{
+		return TextureRef(CreateTextureInner(w, h, f, l, rt, tp, file, line), file, line);
+	}
+
+	int CalcNullPrimIndices(PrimitiveTopology type, int primCount)
+	{
+		switch (type)
+		{
+			case PrimitiveTopology::LineStrip: return primCount + 1;
+			case PrimitiveTopology::LinesList: return primCount * 2;
+			case PrimitiveTopology::TriangleStrip: return primCount + 2;
+			case PrimitiveTopology::TrianglesList: return primCount * 3;
+		}
+
+		return 0;
+	}
+
+	void DeviceNull::ValidateDraw(bool indexed, PrimitiveTopology prim, int startVertex, int startIndex, int primCount, int startInstance, int instanceCount)
+	{
+		Context& ctx = GetContext();
+
+		const char* error = nullptr;
+		int count = CalcNullPrimIndices(prim, primCount);
+
+		if (!ctx.cur_program || !ctx.cur_program->IsLoaded())
+		{
+			error = "program isn't set";
+		}
+		else
+		if (!ctx.cur_vdecl)
+		{
+			error = "vertex declaration isn't set";
+		}
+		else
+		if (!ctx.cur_vbuffers[0])
+		{
+			error = "vertex buffer isn't set";
+		}
+		else
+		if (((VertexDeclNull*)ctx.cur_vdecl)->stride != ctx.cur_vbuffers[0]->GetStride())
+		{
+			error = "stride of vertex buffer doesn't match vertex declaration";
+		}
+		else
+		if (primCount <= 0)
+		{
+			error = "nothing to draw";
+		}
+		else
+		if (indexed && !ctx.cur_ibuffer)
+		{
+			error = "index buffer isn't set";
+		}
+		else
+		if (indexed && (startIndex + count) * ctx.cur_ibuffer->GetStride() > ctx.cur_ibuffer->GetSize())
+		{
+			error = "indices are out of index buffer";
+		}
+		else
+		if (!indexed && (startVertex + count) * ctx.cur_vbuffers[0]->GetStride() > ctx.cur_vbuffers[0]->GetSize())
+		{
+			error = "vertices are out of vertex buffer";
+		}
+		else
+		if (instanceCount > 0 && !ctx.cur_vbuffers[1])
+		{
+			error = "instance buffer isn't set";
+		}
+		else
+		if (instanceCount > 0 && ((VertexDeclNull*)ctx.cur_vdecl)->instanceStride != ctx.cur_vbuffers[1]->GetStride())
+		{
+			error = "stride of instance buffer doesn't match vertex declaration";
+		}
+		else
+		if (instanceCount > 0 && (startInstance + instanceCount) * ctx.cur_vbuffers[1]->GetStride() > ctx.cur_vbuffers[1]->GetSize())
+		{
+			error = "instances are out of instance buffer";
+		}
+
+		if (error)
+		{
+			ctx.stats.validationErrors++;
+			root.Log("Render", "Draw call %i failed validation: %s", ctx.stats.drawCalls, error);
+		}
+	}
+
+	void DeviceNull::Draw(PrimitiveTopology prim, int startVertex, int primCount)
+	{
+		Context& ctx = GetContext();
+
+		FlushBatch();
+
+		if (validation)
+		{
+			ValidateDraw(false, prim, startVertex, 0, primCount, 0, 0);
+		}
+
+		ctx.stats.drawCalls++;
+		ctx.stats.primitives += primCount;
+	}
+
+	void DeviceNull::DrawIndexed(PrimitiveTopology prim, int startVertex, int startIndex, int primCount)
+	{
+		Context& ctx = GetContext();
+
+		FlushBatch();
+
+		if (validation)
+		{
+			ValidateDraw(true, prim, startVertex, startIndex, primCount, 0, 0);
+		}
+
+		ctx.stats.drawCalls++;
+		ctx.stats.primitives += primCount;
+	}
+
+	void DeviceNull::DrawIndexedInstanced(PrimitiveTopology prim, int startVertex, int startIndex, int primCount, int startInstance, int instanceCount)
+	{
+		Context& ctx = GetContext();
+
+		FlushBatch();
+
+		if (validation)
+		{
+			ValidateDraw(true, prim, startVertex, startIndex, primCount, startInstance, instanceCount);
+		}
+
+		ctx.stats.drawCalls++;
+		ctx.stats.primitives += (int64_t)primCount * instanceCount;
+		ctx.stats.instances += instanceCount;
+	}
+
+	void DeviceNull::CountState()
+	{
+		Context& ctx = GetContext();
+
+		FlushBatch();
+
+		ctx.stats.stateChanges++;
+	}
+
+	void DeviceNull::SetAlphaBlend(bool enable)
+	{
+		CountState();
+	}
+
+	void DeviceNull::SetBlendFunc(BlendArg src, BlendArg dest)
+	{
+		CountState();
+	}
+
+	void DeviceNull::SetBlendOperation(BlendOp op)
+	{
+		CountState();
+	}
+
+	void DeviceNull::SetDepthTest(bool enable)
+	{
+		CountState();
+	}
+
+	void DeviceNull::SetDepthWriting(bool enable)
+	{
+		CountState();
+	}
+
+	void DeviceNull::SetDepthFunc(CompareFunc func)
+	{
+		CountState();
+	}
+
+	void DeviceNull::SetCulling(CullMode mode)
+	{
+		CountState();
+	}
+
+	void DeviceNull::SetupSlopeZBias(bool enable, float slopeZBias, float depthOffset)
+	{
+		CountState();
+	}
+
+	void DeviceNull::SetScissors(bool enable)
+	{
+		CountState();
+	}
+
+	void DeviceNull::SetScissorRect(Rect rect)
+	{
+		CountState();
+	}
+
+	void DeviceNull::SetViewport(const Viewport& viewport)
+	{
+		Context& ctx = GetContext();
+
+		CountState();
+
+		ctx.cur_viewport = viewport;
+	}
+
+	void DeviceNull::GetViewport(Viewport& viewport)
+	{
+		Context& ctx = GetContext();
+
+		viewport = ctx.cur_viewport;
+	}
+
+	void DeviceNull::SetRenderTarget(int slot, Texture* rt)
+	{
+		Context& ctx = GetContext();
+
+		CountState();
+
+		if (slot == 0)
+		{
+			cur_rt_w = rt ? rt->GetWidth() : -1;
+			cur_rt_h = rt ? rt->GetHeight() : -1;
+
+			ctx.cur_viewport = { 0, 0, rt ? cur_rt_w : 0, rt ? cur_rt_h : 0, 0.0f, 1.0f };
+		}
+	}
+
+	void DeviceNull::SetDepth(Texture* depth)
+	{
+		CountState();
+	}
+
+	void DeviceNull::RestoreRenderTarget()
+	{
+		Context& ctx = GetContext();
+
+		CountState();
+
+		cur_rt_w = scr_w;
+		cur_rt_h = scr_h;
+
+		ctx.cur_viewport = { 0, 0, scr_w, scr_h, 0.0f, 1.0f };
+	}
+
+	DeviceNull::Context& DeviceNull::GetContext()
+	{
+		return contexts[curContext];
+	}
+
+	int DeviceNull::GetContextIndex()
+	{
+		return curContext;
+	}
+
+	int DeviceNull::GetCommandListsCount()
+	{
+		return maxContexts - 1;
+	}
+
+	void DeviceNull::BeginCommandList(int index)
+	{
+		Context& ctx = contexts[index + 1];
+
+		ctx = Context();
+		ctx.cur_viewport = contexts[0].cur_viewport;
+
+		curContext = index + 1;
+	}
+
+	void DeviceNull::EndCommandList()
+	{
+		GetContext().recorded = true;
+
+		curContext = 0;
+	}
+
+	void DeviceNull::ExecuteCommandList(int index)
+	{
+		Context& list = contexts[index + 1];
+
+		if (!list.recorded)
+		{
+			return;
+		}
+
+		Stats& stats = contexts[0].stats;
+
+		stats.drawCalls += list.stats.drawCalls;
+		stats.primitives += list.stats.primitives;
+		stats.programChanges += list.stats.programChanges;
+		stats.vdeclChanges += list.stats.vdeclChanges;
+		stats.bufferChanges += list.stats.bufferChanges;
+		stats.stateChanges += list.stats.stateChanges;
+		stats.paramUploads += list.stats.paramUploads;
+		stats.paramBytes += list.stats.paramBytes;
+		stats.validationErrors += list.stats.validationErrors;
+		stats.instances += list.stats.instances;
+		stats.commandLists++;
+
+		list.recorded = false;
+	}
+
+	void DeviceNull::Release()
+	{
+		instance = nullptr;
+
+		delete this;
+	}
+}
@@ -0,0 +1,161 @@
+#pragma once
+
+#include "Root/Render/Device.h"
+
+namespace Oak
+{
+	/**
+	\ingroup gr_code_root_render
+	*/
+
+	/**
+	\brief DeviceNull
+
+	Device which doesn't use any GAPI. Resources are kept in a system memory and draw calls are only
+	counted, so render code can be executed and measured on a machine without a GPU. In validation
+	mode every draw call is checked for a bound program, vertex declaration and buffers.
+
+	*/
+
+	class CLASS_DECLSPEC DeviceNull : public Device
+	{
+		friend class Render;
+		friend class DataBufferNull;
+		friend class ShaderNull;
+		friend class TextureNull;
+
+	public:
+
+		/**
+		\brief Statistic collected by a device
+		*/
+		struct Stats
+		{
+			int frames = 0; /*!< Number of presented frames */
+			int drawCalls = 0; /*!< Number of draw calls */
+			int64_t primitives = 0; /*!< Number of drawn primitives */
+			int programChanges = 0; /*!< Number of changes of a program */
+			int vdeclChanges = 0; /*!< Number of changes of a vertex declaration */
+			int bufferChanges = 0; /*!< Number of changes of a vertex or an index buffer */
+			int stateChanges = 0; /*!< Number of changes of blend, depth, raster states, viewports and render targets */
+			int paramUploads = 0; /*!< Number of set shader parameters */
+			int64_t paramBytes = 0; /*!< Size of set shader parameters */
+			int bufferUploads = 0; /*!< Number of unlocks of buffers */
+			int64_t bufferBytes = 0; /*!< Size of data uploaded into buffers */
+			int textureUploads = 0; /*!< Number of updates of textures */
+			int64_t textureBytes = 0; /*!< Size of data uploaded into textures */
+			int validationErrors = 0; /*!< Number of draw calls which failed validation */
+			int commandLists = 0; /*!< Number of executed command lists */
+			int instances = 0; /*!< Number of instances drawn by instanced draw calls */
+		};
+
+	private:
+
+		#ifndef DOXYGEN_SKIP
+
+		constexpr static int maxContexts = 8;
+
+		// index 0 is main context, others are recording lists
+		struct Context
+		{
+			Program* cur_program = nullptr;
+			VertexDecl* cur_vdecl = nullptr;
+			DataBuffer* cur_vbuffers[4] = { nullptr, nullptr, nullptr, nullptr };
+			DataBuffer* cur_ibuffer = nullptr;
+			Viewport cur_viewport;
+			bool recorded = false;
+			Stats stats;
+		};
+
+		Context contexts[maxContexts];
+		bool validation = false;
+
+		Context& GetContext();
+
+		DeviceNull();
+		bool Init(void* external_device) override;
+		void PrepareProgram(Program* program) override;
+		void Release() override;
+
+		Shader* CreateShader(ShaderType type, const char* name) override;
+		Texture* CreateTextureInner(int w, int h, TextureFormat f, int l, bool rt, TextureType tp, const char* file, int line) override;
+		void ResetBuffers(DataBuffer* buffer);
+		void ValidateDraw(bool indexed, PrimitiveTopology prim, int startVertex, int startIndex, int primCount, int startInstance, int instanceCount);
+		void CountState();
+
+		#endif
+
+	public:
+
+		#ifndef DOXYGEN_SKIP
+		static DeviceNull* instance;
+		#endif
+
+		/**
+		\brief Get statistic collected since last reset
+
+		\return Reference to statistic
+		*/
+		const Stats& GetStats();
+
+		/**
+		\brief Reset collected statistic
+		*/
+		void ResetStats();
+
+		/**
+		\brief Controls validation of draw calls. Failed draw calls are logged and counted in Stats::validationErrors.
+
+		\param[in] enable Should validation be enabled
+		*/
+		void SetValidation(bool enable);
+
+		int GetCommandListsCount() override;
+		void BeginCommandList(int index) override;
+		void EndCommandList() override;
+		int GetContextIndex() override;
+		void ExecuteCommandList(int index) override;
+
+		bool SetBackBuffer(int id, int wgt, int hgt, void* data) override;
+		int GetWidth() override;
+		int GetHeight() override;
+		float GetAspect() override;
+
+		void Clear(bool renderTarget, Color color, bool zbuffer, float zValue) override;
+		void Present() override;
+
+		void SetProgram(Program* program) override;
+
+		VertexDeclRef CreateVertexDecl(int count, VertexDecl::ElemDesc* elems, const char* file, int line) override;
+		void SetVertexDecl(VertexDecl* vdecl) override;
+
+		DataBufferRef CreateBuffer(int count, int stride, const char* file, int line) override;
+		void SetVertexBuffer(int slot, DataBuffer* buffer) override;
+		void SetIndexBuffer(DataBuffer* buffer) override;
+
+		TextureRef CreateTexture(int w, int h, TextureFormat f, int l, bool rt, TextureType tp, const char* file, int line) override;
+
+		void Draw(PrimitiveTopology prim, int startVertex, int primCount) override;
+		void DrawIndexed(PrimitiveTopology prim, int startVertex, int startIndex, int primCount) override;
+		void DrawIndexedInstanced(PrimitiveTopology prim, int startVertex, int startIndex, int primCount, int startInstance, int instanceCount) override;
+
+		void SetAlphaBlend(bool enable) override;
+		void SetBlendFunc(BlendArg src, BlendArg dest) override;
+		void SetBlendOperation(BlendOp op) override;
+		void SetDepthTest(bool enable) override;
+		void SetDepthWriting(bool enable) override;
+		void SetDepthFunc(CompareFunc func) override;
+		void SetCulling(CullMode mode) override;
+		void SetupSlopeZBias(bool enable, float slopeZBias, float depthOffset) override;
+
+		void SetScissors(bool enable) override;
+		void SetScissorRect(Rect rect) override;
+
+		void SetViewport(const Viewport& viewport) override;
+		void GetViewport(Viewport& viewport) override;
+
+		void SetRenderTarget(int slot, Texture* rt) override;
+		void SetDepth(Texture* depth) override;
+		void RestoreRenderTarget() override;
+	};
+}
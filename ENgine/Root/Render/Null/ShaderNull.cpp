@@ -0,0 +1,80 @@
+
+#include "ShaderNull.h"
+#include "DeviceNull.h"
+
+namespace Oak
+{
+	ShaderNull::ShaderNull(ShaderType tp) : Shader(tp)
+	{
+		loaded = true;
+	}
+
+	int ShaderNull::GetParam(const char* param)
+	{
+		// there is no reflection, so every requested parameter is treated as existing one
+		auto iter = paramsSearch.find_as(param, eastl::less_2<eastl::string, const char*>());
+
+		if (iter != paramsSearch.end())
+		{
+			return iter->second;
+		}
+
+		int index = (int)paramsSearch.size();
+		paramsSearch[param] = index;
+
+		return index;
+	}
+
+	bool ShaderNull::SetVector(int param, Math::Vector4* v, int count)
+	{
+		if (param == -1)
+		{
+			return false;
+		}
+
+		DeviceNull::instance->GetContext().stats.paramUploads++;
+		DeviceNull::instance->GetContext().stats.paramBytes += sizeof(Math::Vector4) * count;
+
+		return true;
+	}
+
+	bool ShaderNull::SetMatrix(int param, Math::Matrix* m, int count)
+	{
+		if (param == -1)
+		{
+			return false;
+		}
+
+		DeviceNull::instance->GetContext().stats.paramUploads++;
+		DeviceNull::instance->GetContext().stats.paramBytes += sizeof(Math::Matrix) * count;
+
+		return true;
+	}
+
+	bool ShaderNull::SetTexture(int param, Texture* tex)
+	{
+		if (param == -1)
+		{
+			return false;
+		}
+
+		DeviceNull::instance->GetContext().stats.paramUploads++;
+
+		return true;
+	}
+
+	void ShaderNull::Apply()
+	{
+
+	}
+
+	void ShaderNull::UpdateConstants()
+	{
+
+	}
+
+	void ShaderNull::Release()
+	{
+		delete this;
+	}
+}
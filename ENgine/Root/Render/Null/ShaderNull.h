@@ -0,0 +1,27 @@
+#pragma once
+
+#include "Root/Render/Shader.h"
+#include <eastl/map.h>
+#include <eastl/string.h>
+
+namespace Oak
+{
+	class ShaderNull : public Shader
+	{
+		eastl::map<eastl::string, int> paramsSearch;
+
+		virtual void Release();
+
+	public:
+
+		ShaderNull(ShaderType tp);
+
+		virtual int GetParam(const char* param);
+		virtual bool SetVector(int param, Math::Vector4* v, int count);
+		virtual bool SetMatrix(int param, Math::Matrix* m, int count);
+		virtual bool SetTexture(int param, Texture* tex);
+
+		virtual void Apply();
+		virtual void UpdateConstants();
+	};
+}
@@ -0,0 +1,54 @@
+
+#include "TextureNull.h"
+#include "DeviceNull.h"
+#include "Root/Root.h"
+
+namespace Oak
+{
+	TextureNull::TextureNull(int w, int h, TextureFormat f, int l, TextureType tp) : Texture(w, h, f, l, tp)
+	{
+		if (lods == 0)
+		{
+			lods = GetLevels(width, height, 1);
+		}
+	}
+
+	void TextureNull::Resize(int setWidth, int setHeight)
+	{
+		width = setWidth;
+		height = setHeight;
+	}
+
+	void TextureNull::GenerateMips()
+	{
+
+	}
+
+	void TextureNull::Update(int level, int layer, uint8_t* data, int stride)
+	{
+		int levelHeight = height >> level;
+
+		DeviceNull::instance->GetContext().stats.textureUploads++;
+		DeviceNull::instance->GetContext().stats.textureBytes += stride * (levelHeight > 0 ? levelHeight : 1);
+	}
+
+	void* TextureNull::GetNativeResource()
+	{
+		return nullptr;
+	}
+
+	void TextureNull::Apply(int slot)
+	{
+
+	}
+
+	void TextureNull::Release()
+	{
+		if (root.render.textures.count(name) > 0)
+		{
+			root.render.textures.erase(name);
+		}
+
+		delete this;
+	}
+}
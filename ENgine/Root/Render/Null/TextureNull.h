@@ -0,0 +1,29 @@
+#pragma once
+
+#include "Root/Render/Texture.h"
+
+namespace Oak
+{
+	class TextureNull : public Texture
+	{
+		friend class DeviceNull;
+
+		virtual void Release();
+
+		TextureNull(int w, int h, TextureFormat f, int l, TextureType tp);
+
+		public:
+
+		void Resize(int width, int height) override;
+
+		void GenerateMips() override;
+
+		void Update(int level, int layer, uint8_t* data, int stride) override;
+
+		void* GetNativeResource() override;
+
+		protected:
+
+		void Apply(int slot) override;
+	};
+}
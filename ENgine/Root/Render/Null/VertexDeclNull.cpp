@@ -0,0 +1,27 @@
+
+#include "VertexDeclNull.h"
+
+namespace Oak
+{
+	VertexDeclNull::VertexDeclNull(int count, VertexDecl::ElemDesc* elems)
+	{
+		uint8_t sizes[] = { 4, 8, 12, 16, 4, 8, 12, 16, 4, 8, 12, 16, 4 };
+
+		for (int i = 0; i < count; i++)
+		{
+			if (elems[i].instanced)
+			{
+				instanceStride += sizes[(int)elems[i].type];
+			}
+			else
+			{
+				stride += sizes[(int)elems[i].type];
+			}
+		}
+	}
+
+	void VertexDeclNull::Release()
+	{
+		delete this;
+	}
+}
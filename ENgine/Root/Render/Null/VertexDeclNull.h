@@ -0,0 +1,18 @@
+#pragma once
+
+#include "Root/Render/VertexDecl.h"
+
+namespace Oak
+{
+	class VertexDeclNull : public VertexDecl
+	{
+		virtual void Release();
+
+	public:
+
+		int stride = 0;
+		int instanceStride = 0;
+
+		VertexDeclNull(int count, VertexDecl::ElemDesc* elems);
+	};
+}
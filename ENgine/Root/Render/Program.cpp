@@ -3,25 +3,73 @@
 
 namespace Oak
 {
-	eastl::map<eastl::string, Math::Vector4> Program::vectors;
-	eastl::map<eastl::string, Math::Matrix> Program::matrixes;
-	eastl::map<eastl::string, Texture*> Program::textures;
+	eastl::map<eastl::string, int> Program::globalsSearch;
+	eastl::vector<Math::Vector4> Program::vectors;
+	eastl::vector<Math::Matrix> Program::matrixes;
+	eastl::vector<Texture*> Program::textures;
+
+	int Program::GetGlobalParam(const char* param)
+	{
+		auto iter = globalsSearch.find_as(param, eastl::less_2<eastl::string, const char*>());
+
+		if (iter != globalsSearch.end())
+		{
+			return iter->second;
+		}
+
+		int index = (int)vectors.size();
+		globalsSearch[param] = index;
+
+		vectors.push_back(Math::Vector4());
+		matrixes.push_back(Math::Matrix());
+		textures.push_back(nullptr);
+
+		return index;
+	}
+
+	void Program::SetVector(int param, Math::Vector4* v)
+	{
+		memcpy(&vectors[param].x, &v->x, 4 * 4);
+	}
+
+	void Program::SetMatrix(int param, Math::Matrix* mat)
+	{
+		memcpy(&matrixes[param].m[0][0], &mat->m[0][0], 16 * 4);
+	}
+
+	void Program::SetTexture(int param, Texture* texture)
+	{
+		textures[param] = texture;
+	}
+
+	Math::Vector4& Program::GetVector(int param)
+	{
+		return vectors[param];
+	}
+
+	Math::Matrix& Program::GetMatrix(int param)
+	{
+		return matrixes[param];
+	}
+
+	Texture* Program::GetTexture(int param)
+	{
+		return textures[param];
+	}
 
 	void Program::SetVector(const char* param, Math::Vector4* v)
 	{
-		Math::Vector4& vec = vectors[param];
-		memcpy(&vec.x, &v->x, 4 * 4);
+		SetVector(GetGlobalParam(param), v);
 	}
 
 	void Program::SetMatrix(const char* param, Math::Matrix* mat)
 	{
-		Math::Matrix& mt = matrixes[param];
-		memcpy(&mt.m[0][0], &mat->m[0][0], 16 * 4);
+		SetMatrix(GetGlobalParam(param), mat);
 	}
 
 	void Program::SetTexture(const char* param, Texture* texture)
 	{
-		textures[param] = texture;
+		SetTexture(GetGlobalParam(param), texture);
 	}
 
 	bool Program::Init()
@@ -39,43 +87,60 @@ namespace Oak
 		return true;
 	}
 
-	void Program::SetVector(ShaderType shader_type, const char* param, Math::Vector4* v, int count)
+	bool Program::IsLoaded()
 	{
-		if (shader_type == ShaderType::Vertex)
-		{
-			if (vshader) vshader->SetVector(param, v, count);
-		}
+		return vshader && vshader->IsLoaded() && pshader && pshader->IsLoaded();
+	}
+
+	Program::Param Program::GetParam(ShaderType shader_type, const char* param)
+	{
+		Param handle;
+		handle.type = shader_type;
+
+		Shader* shader = (shader_type == ShaderType::Vertex) ? vshader : pshader;
 
-		if (shader_type == ShaderType::Pixel)
+		if (shader)
 		{
-			if (pshader) pshader->SetVector(param, v, count);
+			handle.index = shader->GetParam(param);
 		}
+
+		return handle;
 	}
 
-	void Program::SetMatrix(ShaderType shader_type, const char* param, Math::Matrix* mat, int count)
+	void Program::SetVector(Param param, Math::Vector4* v, int count)
 	{
-		if (shader_type == ShaderType::Vertex)
-		{
-			if (vshader) vshader->SetMatrix(param, mat, count);
-		}
+		Shader* shader = (param.type == ShaderType::Vertex) ? vshader : pshader;
 
-		if (shader_type == ShaderType::Pixel)
-		{
-			if (pshader) pshader->SetMatrix(param, mat, count);
-		}
+		if (shader) shader->SetVector(param.index, v, count);
 	}
 
-	void Program::SetTexture(ShaderType shader_type, const char* param, Texture* texture)
+	void Program::SetMatrix(Param param, Math::Matrix* mat, int count)
 	{
-		if (shader_type == ShaderType::Vertex)
-		{
-			if (vshader) vshader->SetTexture(param, texture);
-		}
+		Shader* shader = (param.type == ShaderType::Vertex) ? vshader : pshader;
 
-		if (shader_type == ShaderType::Pixel)
-		{
-			if (pshader) pshader->SetTexture(param, texture);
-		}
+		if (shader) shader->SetMatrix(param.index, mat, count);
+	}
+
+	void Program::SetTexture(Param param, Texture* texture)
+	{
+		Shader* shader = (param.type == ShaderType::Vertex) ? vshader : pshader;
+
+		if (shader) shader->SetTexture(param.index, texture);
+	}
+
+	void Program::SetVector(ShaderType shader_type, const char* param, Math::Vector4* v, int count)
+	{
+		SetVector(GetParam(shader_type, param), v, count);
+	}
+
+	void Program::SetMatrix(ShaderType shader_type, const char* param, Math::Matrix* mat, int count)
+	{
+		SetMatrix(GetParam(shader_type, param), mat, count);
+	}
+
+	void Program::SetTexture(ShaderType shader_type, const char* param, Texture* texture)
+	{
+		SetTexture(GetParam(shader_type, param), texture);
 	}
 
 	void Program::Release()
@@ -4,6 +4,7 @@
 #include "Shader.h"
 #include "Texture.h"
 #include <eastl/map.h>
+#include <eastl/vector.h>
 #include "Support/ClassFactory.h"
 #include "Support/PointerRef.h"
 
@@ -35,12 +36,14 @@ namespace Oak
 
 		friend class DeviceDX11;
 		friend class DeviceGLES;
+		friend class DeviceNull;
 
 	protected:
 
-		static eastl::map<eastl::string, Math::Vector4> vectors;
-		static eastl::map<eastl::string, Math::Matrix> matrixes;
-		static eastl::map<eastl::string, Texture*> textures;
+		static eastl::map<eastl::string, int> globalsSearch;
+		static eastl::vector<Math::Vector4> vectors;
+		static eastl::vector<Math::Matrix> matrixes;
+		static eastl::vector<Texture*> textures;
 
 		virtual bool Init();
 		void Release();
@@ -50,6 +53,75 @@ namespace Oak
 
 	public:
 
+		/**
+		\brief Handle of a parameter of a program. Handle is resolved once via GetParam and stays valid while program is alive.
+		*/
+		struct Param
+		{
+			ShaderType type = ShaderType::Vertex; /*!< Type of a shader which owns a parameter */
+			int index = -1; /*!< Index of a parameter in a shader. -1 means that parameter wasn't found */
+		};
+
+		/**
+		\brief Get handle of a parameter in global pool. Parameter is added if it wasn't in a pool.
+
+		\param[in] param Name of a parameter
+
+		\return Handle of a parameter
+		*/
+		static int GetGlobalParam(const char* param);
+
+		/**
+		\brief Store a 4 componet vector in global pool
+
+		\param[in] param Handle of a parameter
+		\param[in] v Pointer to a vector
+		*/
+		static void SetVector(int param, Math::Vector4* v);
+
+		/**
+		\brief Store a matrix in global pool
+
+		\param[in] param Handle of a parameter
+		\param[in] mat Pointer to a matrix
+		*/
+		static void SetMatrix(int param, Math::Matrix* mat);
+
+		/**
+		\brief Store texture in global pool
+
+		\param[in] param Handle of a parameter
+		\param[in] texture Pointer to a texture
+		*/
+		static void SetTexture(int param, Texture* texture);
+
+		/**
+		\brief Get a 4 componet vector from global pool
+
+		\param[in] param Handle of a parameter
+
+		\return Reference to a vector
+		*/
+		static Math::Vector4& GetVector(int param);
+
+		/**
+		\brief Get a matrix from global pool
+
+		\param[in] param Handle of a parameter
+
+		\return Reference to a matrix
+		*/
+		static Math::Matrix& GetMatrix(int param);
+
+		/**
+		\brief Get a texture from global pool
+
+		\param[in] param Handle of a parameter
+
+		\return Pointer to a texture
+		*/
+		static Texture* GetTexture(int param);
+
 		/**
 		\brief Store a 4 componet vector in global pool
 
@@ -88,6 +160,13 @@ namespace Oak
 		*/
 		virtual const char* GetPsName() = 0;
 
+		/**
+		\brief Check if both shaders of a program were loaded
+
+		\return True will be returned if program is ready for use
+		*/
+		bool IsLoaded();
+
 		/**
 		\brief Set 4 component vector for a parameter
 
@@ -100,6 +179,42 @@ namespace Oak
 		*/
 		void SetVector(ShaderType shader_type, const char* param, Math::Vector4* v, int count);
 
+		/**
+		\brief Get handle of a parameter
+
+		\param[in] shader_type Type of shader
+		\param[in] param Name of a parameter
+
+		\return Handle of a parameter
+		*/
+		Param GetParam(ShaderType shader_type, const char* param);
+
+		/**
+		\brief Set 4 component vector for a parameter
+
+		\param[in] param Handle of a parameter
+		\param[in] v Pointer to vectors
+		\param[in] count Number of vectors needed to be set
+		*/
+		void SetVector(Param param, Math::Vector4* v, int count);
+
+		/**
+		\brief Set matrices for a parameter
+
+		\param[in] param Handle of a parameter
+		\param[in] mat Pointer to a matrices
+		\param[in] count Number of matrices needed to be set
+		*/
+		void SetMatrix(Param param, Math::Matrix* mat, int count);
+
+		/**
+		\brief Set texture for a parameter
+
+		\param[in] param Handle of a parameter
+		\param[in] texture Pointer to a texture
+		*/
+		void SetTexture(Param param, Texture* texture);
+
 		/**
 		\brief Set matrices for a parameter
 
@@ -11,6 +11,8 @@
 #include "DX11/DeviceDX11.h"
 #endif
 
+#include "Null/DeviceNull.h"
+
 #define STBI_NO_GIF
 #define STBI_NO_HDR
 #define STBI_NO_PIC
@@ -24,12 +26,23 @@ namespace Oak
 	bool Render::Init(const char* device_name, void* external_device)
 	{
 		#ifdef PLATFORM_WIN
-		device = NEW DeviceDX11();
+		if (!StringUtils::IsEqual(device_name, "Null"))
+		{
+			device = NEW DeviceDX11();
+		}
 		#endif
 
+		if (!device)
+		{
+			device = NEW DeviceNull();
+		}
+
 		groupTaskPool = root.taskExecutor.CreateGroupTaskPool(_FL_);
 		debugTaskPool = groupTaskPool->AddTaskPool(_FL_);
 
+		commandsExecutor.owner = this;
+		groupTaskPool->SetLevelFinishedCallback(&commandsExecutor, (Object::Delegate)&CommandsExecutor::Execute);
+
 		if (!device->Init(external_device))
 		{
 			return false;
@@ -201,6 +214,7 @@ namespace Oak
 	void Render::ExecutePool(int level, float dt)
 	{
 		groupTaskPool->ExecutePool(level, dt);
+		device->FlushBatch();
 	}
 
 	TaskExecutor::SingleTaskPool* Render::AddTaskPool(const char* file, int line)
@@ -208,14 +222,50 @@ namespace Oak
 		return groupTaskPool->AddTaskPool(file, line);
 	}
 
+	void Render::AttachTaskPool(TaskExecutor::SingleTaskPool* pool)
+	{
+		groupTaskPool->AttachTaskPool(pool);
+	}
+
 	void Render::DelTaskPool(TaskExecutor::SingleTaskPool* pool)
 	{
 		groupTaskPool->DelTaskPool(pool);
 	}
 
+	CommandBuffer* Render::GetCommandBuffer()
+	{
+		static thread_local CommandBuffer* threadBuffer = nullptr;
+
+		if (!threadBuffer)
+		{
+			threadBuffer = NEW CommandBuffer();
+
+			commandBuffersLock.Enter();
+			commandBuffers.push_back(threadBuffer);
+			commandBuffersLock.UnLock();
+		}
+
+		return threadBuffer;
+	}
+
+	void Render::ExecuteCommands()
+	{
+		commandBuffersLock.Enter();
+
+		CommandBuffer::Execute(device, commandBuffers.data(), (int)commandBuffers.size());
+
+		commandBuffersLock.UnLock();
+	}
+
+	void Render::CommandsExecutor::Execute(float dt)
+	{
+		owner->ExecuteCommands();
+	}
+
 	void Render::Execute(float dt)
 	{
 		groupTaskPool->Execute(dt);
+		device->FlushBatch();
 	}
 
 	void Render::DebugLine(Math::Vector3 from, Color from_clr, Math::Vector3 to, Color to_clr, bool use_depth)
@@ -337,6 +387,14 @@ namespace Oak
 		groupTaskPool->DelTaskPool(debugTaskPool);
 		delete groupTaskPool;
 
+		for (auto* buffer : commandBuffers)
+		{
+			delete buffer;
+		}
+
+		commandBuffers.clear();
+		CommandBuffer::ReleaseInstanceBuffers();
+
 		whiteTex.ReleaseRef();
 		RELEASE(lines)
 		RELEASE(spheres)
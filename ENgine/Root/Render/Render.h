@@ -3,6 +3,7 @@
 
 #include "Root/Render/Device.h"
 #include "Root/Render/Program.h"
+#include "Root/Render/CommandBuffer.h"
 #include "Root/TaskExecutor/TaskExecutor.h"
 #include <eastl/vector.h>
 #include <eastl/map.h>
@@ -50,6 +51,7 @@ namespace Oak
 		friend class Program;
 		friend class Texture;
 		friend class TextureDX11;
+		friend class TextureNull;
 		friend class TextureGLES;
 
 		#ifndef DOXYGEN_SKIP
@@ -73,6 +75,18 @@ namespace Oak
 		TaskExecutor::GroupTaskPool* groupTaskPool;
 		TaskExecutor::SingleTaskPool* debugTaskPool;
 
+		class CommandsExecutor : public Object
+		{
+		public:
+			Render* owner = nullptr;
+
+			void Execute(float dt);
+		};
+
+		CommandsExecutor commandsExecutor;
+		eastl::vector<CommandBuffer*> commandBuffers;
+		CriticalSection commandBuffersLock;
+
 		TextureRef whiteTex;
 
 		bool Init(const char* device, void* external_device);
@@ -146,6 +160,26 @@ namespace Oak
 		*/
 		TaskExecutor::SingleTaskPool* AddTaskPool(const char* file, int line);
 
+		/**
+		\brief Adds existing task pool to a group render task pool
+
+		\param[in] pool Pointer to a task pool
+		*/
+		void AttachTaskPool(TaskExecutor::SingleTaskPool* pool);
+
+		/**
+		\brief Get command buffer of a calling thread. Recorded commands are sorted and replayed after all tasks
+		of a current level of render task pool were executed, so render tasks can record from worker threads.
+
+		\return Pointer to a command buffer
+		*/
+		CommandBuffer* GetCommandBuffer();
+
+		/**
+		\brief Replay commands recorded by all threads. Should be called from main thread.
+		*/
+		void ExecuteCommands();
+
 		/**
 		\brief Deletes task pool from a group render task pool
 
@@ -37,41 +37,59 @@ namespace Oak
 		Shader(ShaderType tp) { shaderType = tp; };
 
 		/**
-		\brief Set 4 component vector for a parameter
+		\brief Find index of a parameter. Index stays valid while shader is alive.
 
 		\param[in] param Name of a parameter
+
+		\return Index of a parameter or -1 if shader doesn't have such parameter
+		*/
+		virtual int GetParam(const char* param) = 0;
+
+		/**
+		\brief Set 4 component vector for a parameter
+
+		\param[in] param Index of a parameter
 		\param[in] v Pointer to vectors
 		\param[in] count Number of vectors needed to be set
 
 		\return Result of an operation
 		*/
-		virtual bool SetVector(const char* param, Math::Vector4* v, int count) = 0;
+		virtual bool SetVector(int param, Math::Vector4* v, int count) = 0;
 
 		/**
 		\brief Set matrices for a parameter
 
-		\param[in] param Name of a parameter
+		\param[in] param Index of a parameter
 		\param[in] m Pointer to a matrices
 		\param[in] count Number of matrices needed to be set
 
 		\return Result of an operation
 		*/
-		virtual bool SetMatrix(const char* param, Math::Matrix* m, int count) = 0;
+		virtual bool SetMatrix(int param, Math::Matrix* m, int count) = 0;
 
 		/**
 		\brief Set texture for a parameter
 
-		\param[in] param Name of a parameter
+		\param[in] param Index of a parameter
 		\param[in] tex Pointer to a texture
 
 		\return Result of an operation
 		*/
-		virtual bool SetTexture(const char* param, Texture* tex) = 0;
+		virtual bool SetTexture(int param, Texture* tex) = 0;
+
+		/**
+		\brief Check if shader was loaded
+
+		\return True will be returned if shader is ready for use
+		*/
+		bool IsLoaded() { return loaded; };
 
 	protected:
 
 		#ifndef DOXYGEN_SKIP
 
+		bool loaded = false;
+
 		virtual void UpdateConstants() = 0;
 		virtual void Apply() = 0;
 		ShaderType shaderType;
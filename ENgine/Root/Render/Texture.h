@@ -71,6 +71,7 @@ namespace Oak
 		friend class Render;
 		friend class DeviceDX11;
 		friend class TextureDX11;
+		friend class TextureNull;
 		friend class PointerRef<Texture>;
 
 		#ifndef DOXYGEN_SKIP
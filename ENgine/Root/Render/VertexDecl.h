@@ -67,6 +67,9 @@ namespace Oak
 
 			/** \brief index of an element*/
 			int index;
+
+			/** \brief element is taken once per instance from a buffer in slot 1 */
+			bool instanced = false;
 		};
 	};
 
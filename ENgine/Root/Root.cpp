@@ -3,6 +3,7 @@
 #include "Support/Timer.h"
 #include "Support/StringUtils.h"
 #include "Support/Sprite.h"
+#include "Root/Scenes/SceneEntity.h"
 
 #include <ctime>
 #include <stdio.h>
@@ -28,7 +29,7 @@ namespace Oak
 		logsDir[0] = 0;
 	}
 
-	bool Root::Init(void* renderData)
+	bool Root::Init(void* renderData, const char* renderDevice)
 	{
 		srand((unsigned int)time(nullptr));
 
@@ -47,6 +48,8 @@ namespace Oak
 
 		#endif
 
+		taskExecutor.Init();
+
 		if (!files.Init())
 		{
 			return false;
@@ -64,7 +67,7 @@ namespace Oak
 			return false;
 		}
 
-		if (!render.Init("DX11", renderData))
+		if (!render.Init(renderDevice, renderData))
 		{
 			return false;
 		}
@@ -158,6 +161,7 @@ namespace Oak
 
 		physics.Fetch();
 
+		memory.ResetFrame();
 	}
 
 	float Root::GetDeltaTime()
@@ -186,13 +190,24 @@ namespace Oak
 
 		Sprite::Release();
 
+		particles.Release();
 		fonts.Release();
 		render.Release();
 		controls.Release();
 		sounds.Release();
+		taskExecutor.Release();
+
+		for (auto decl : ClassFactorySceneEntity::Decls())
+		{
+			if (decl->GetPool())
+			{
+				decl->GetPool()->Release();
+			}
+		}
 
 		redirectLog = false;
 
+		memory.Release();
 		memory.LogMemory();
 	}
 }
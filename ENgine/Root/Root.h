@@ -126,7 +126,7 @@ namespace Oak
 
 		Root();
 		~Root() = default;
-		bool Init(void* renderData);
+		bool Init(void* renderData, const char* renderDevice = "DX11");
 
 		void Update();
 		void CountDeltaTime();
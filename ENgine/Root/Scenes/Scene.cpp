@@ -1,13 +1,45 @@
 
 #include "Root/Scenes/SceneEntity.h"
 #include "Root/Root.h"
+#include "Support/Timer.h"
 
 namespace Oak
 {
-	void Scene::Init()
+	// meta data of a class is shared by all instances, so it is locked while a scene is streaming on a loading thread
+	CriticalSection Scene::metaDataLock;
+
+	void Scene::Init(bool attachRenderPool)
 	{
 		taskPool = root.taskExecutor.CreateSingleTaskPool(_FL_);
-		renderTaskPool = root.render.AddTaskPool(_FL_);
+		renderTaskPool = root.taskExecutor.CreateSingleTaskPool(_FL_);
+
+		culler.owner = this;
+		renderTaskPool->AddTask(cullingLevel, &culler, (Object::Delegate)&Culler::Execute);
+
+		if (attachRenderPool)
+		{
+			AttachRenderPool();
+		}
+	}
+
+	void Scene::AttachRenderPool()
+	{
+		if (!renderPoolAttached)
+		{
+			root.render.AttachTaskPool(renderTaskPool);
+			renderPoolAttached = true;
+		}
+	}
+
+	void Scene::Culler::Execute(float dt)
+	{
+		Math::Matrix view;
+		root.render.GetTransform(TransformStage::View, view);
+
+		Math::Matrix proj;
+		root.render.GetTransform(TransformStage::Projection, proj);
+
+		owner->spatialIndex.Cull(view * proj);
 	}
 
 	SceneEntity* Scene::CreateEntity(const char* name, bool setNameAndUDID)
@@ -19,6 +51,13 @@ namespace Oak
 			return nullptr;
 		}
 
+		return CreateEntity(decl, setNameAndUDID);
+	}
+
+	SceneEntity* Scene::CreateEntity(ClassFactorySceneEntity* decl, bool setNameAndUDID)
+	{
+		metaDataLock.Enter();
+
 		SceneEntity* entity = decl->Create(_FL_);
 
 		if (entity)
@@ -27,6 +66,7 @@ namespace Oak
 
 			entity->scene = this;
 			entity->className = decl->GetName();
+			entity->decl = decl;
 			entity->Init();
 
 			entity->GetMetaData()->Prepare(entity);
@@ -39,6 +79,8 @@ namespace Oak
 			}
 		}
 
+		metaDataLock.UnLock();
+
 		return entity;
 	}
 
@@ -110,6 +152,8 @@ namespace Oak
 
 	void Scene::Clear()
 	{
+		groups.clear();
+
 		for (auto& entity : entities)
 		{
 			RELEASE(entity);
@@ -137,7 +181,9 @@ namespace Oak
 
 				auto& transform = entity->GetTransform();
 
+				metaDataLock.Enter();
 				entity->Load(reader);
+				metaDataLock.UnLock();
 
 				LoadEntities(reader, "childs", entity->childs);
 
@@ -154,13 +200,83 @@ namespace Oak
 			reader.LeaveBlock();
 		}
 
+		ApplyLoadedEntities(entities);
+	}
+
+	void Scene::ApplyLoadedEntities(eastl::vector<SceneEntity*>& entities)
+	{
+		if (deferApply)
+		{
+			pendingApply.insert(pendingApply.end(), entities.begin(), entities.end());
+			return;
+		}
+
 		for (auto entity : entities)
 		{
-			entity->GetMetaData()->Prepare(entity);
-			entity->GetMetaData()->PostLoad(this);
+			ApplyLoadedEntity(entity);
+		}
+	}
 
-			entity->ApplyProperties();
+	void Scene::ApplyLoadedEntity(SceneEntity* entity)
+	{
+		metaDataLock.Enter();
+
+		entity->GetMetaData()->Prepare(entity);
+		entity->GetMetaData()->PostLoad(this);
+
+		metaDataLock.UnLock();
+
+		entity->ApplyProperties();
+	}
+
+	bool Scene::FinishLoading(double deadline)
+	{
+		while (pendingApplyIndex < pendingApply.size())
+		{
+			ApplyLoadedEntity(pendingApply[pendingApplyIndex]);
+			pendingApplyIndex++;
+
+			if (Timer::GetTime() > deadline)
+			{
+				break;
+			}
+		}
+
+		if (pendingApplyIndex < pendingApply.size())
+		{
+			return false;
 		}
+
+		pendingApply.clear();
+		pendingApplyIndex = 0;
+		deferApply = false;
+
+		return true;
+	}
+
+	float Scene::GetApplyProgress()
+	{
+		return pendingApply.size() > 0 ? (float)pendingApplyIndex / (float)pendingApply.size() : 1.0f;
+	}
+
+	bool Scene::ReleaseEntities(double deadline)
+	{
+		groups.clear();
+
+		while (entities.size() > 0)
+		{
+			SceneEntity* entity = entities.back();
+			entities.pop_back();
+
+			RELEASE(entity);
+
+			if (Timer::GetTime() > deadline)
+			{
+				break;
+			}
+		}
+
+		return entities.size() == 0;
 	}
 
 	void Scene::Load(const char* name)
@@ -175,6 +291,7 @@ namespace Oak
 			StringUtils::RemoveExtension(sceneName);
 
 			reader.Read("uid", uid);
+			LoadPools(reader);
 			LoadEntities(reader, "entities", entities);
 		}
 	}
@@ -211,10 +328,294 @@ namespace Oak
 		{
 			writer.Write("uid", uid);
 
+			SavePools(writer);
 			SaveEntities(writer, "entities", entities);
 		}
 	}
 
+	// Binary scene is a packed copy of JSON scene. Header holds table of used classes with hash of
+	// layout of their properties, entities refer to classes by index and store values of properties
+	// in order of meta data. If layout of any class was changed binary scene is rejected.
+
+	constexpr uint32_t binarySceneMagic = 0x4E43534F;
+	constexpr uint32_t binarySceneVersion = 1;
+
+	void Scene::GetBinaryPath(const char* name, char* path, int len)
+	{
+		StringUtils::Printf(path, len, "%s.bin", name);
+	}
+
+	bool Scene::LoadBinary(const char* name)
+	{
+		BinaryReader reader;
+
+		if (!reader.Open(name))
+		{
+			return false;
+		}
+
+		uint32_t magic = 0;
+		uint32_t version = 0;
+
+		reader.Read(magic);
+		reader.Read(version);
+
+		if (magic != binarySceneMagic || version != binarySceneVersion)
+		{
+			return false;
+		}
+
+		reader.Read(uid);
+
+		uint32_t classesCount = 0;
+		reader.Read(classesCount);
+
+		eastl::vector<BinaryClass> classes;
+		classes.resize(classesCount);
+
+		for (auto& cls : classes)
+		{
+			eastl::string className;
+			uint32_t capacity = 0;
+
+			reader.Read(className);
+			reader.Read(cls.layoutHash);
+			reader.Read(capacity);
+
+			cls.decl = ClassFactorySceneEntity::Find(className.c_str());
+
+			if (!cls.decl || reader.IsFailed())
+			{
+				return false;
+			}
+
+			if (cls.decl->GetPool())
+			{
+				cls.decl->GetPool()->Reserve(capacity);
+			}
+		}
+
+		StringUtils::GetPath(name, scenePath);
+		StringUtils::GetFileName(name, sceneName);
+		StringUtils::RemoveExtension(sceneName);
+		StringUtils::RemoveExtension(sceneName);
+
+		if (!LoadEntities(reader, classes, entities))
+		{
+			pendingApply.clear();
+			Clear();
+
+			return false;
+		}
+
+		return true;
+	}
+
+	bool Scene::LoadEntities(BinaryReader& reader, eastl::vector<BinaryClass>& classes, eastl::vector<SceneEntity*>& entities)
+	{
+		uint32_t count = 0;
+		reader.Read(count);
+
+		entities.reserve(entities.size() + count);
+
+		for (uint32_t i = 0; i < count; i++)
+		{
+			uint16_t classIndex = 0;
+			uint32_t entityUID = 0;
+
+			reader.Read(classIndex);
+			reader.Read(entityUID);
+
+			if (reader.IsFailed() || classIndex >= classes.size())
+			{
+				return false;
+			}
+
+			BinaryClass& cls = classes[classIndex];
+
+			SceneEntity* entity = CreateEntity(cls.decl, false);
+
+			if (!entity)
+			{
+				return false;
+			}
+
+			entities.push_back(entity);
+
+			metaDataLock.Enter();
+
+			if (!cls.layoutChecked)
+			{
+				cls.layoutChecked = entity->GetMetaData()->GetLayoutHash() == cls.layoutHash;
+			}
+
+			if (cls.layoutChecked)
+			{
+				entity->uid = entityUID;
+				entity->Load(reader);
+			}
+
+			metaDataLock.UnLock();
+
+			if (!cls.layoutChecked)
+			{
+				return false;
+			}
+
+			if (!LoadEntities(reader, classes, entity->childs))
+			{
+				return false;
+			}
+
+			auto& transform = entity->GetTransform();
+
+			for (auto child : entity->childs)
+			{
+				child->parent = entity;
+				child->GetTransform().parent = &transform.global;
+			}
+		}
+
+		if (reader.IsFailed())
+		{
+			return false;
+		}
+
+		ApplyLoadedEntities(entities);
+
+		return true;
+	}
+
+	#ifdef OAK_EDITOR
+	void Scene::SaveBinary(const char* name)
+	{
+		BinaryWriter writer;
+
+		if (!writer.Start(name))
+		{
+			return;
+		}
+
+		writer.Write(binarySceneMagic);
+		writer.Write(binarySceneVersion);
+		writer.Write(uid);
+
+		eastl::vector<ClassFactorySceneEntity*> classes;
+		eastl::vector<SceneEntity*> samples;
+		eastl::vector<int> capacities;
+
+		for (auto decl : ClassFactorySceneEntity::Decls())
+		{
+			SceneEntity* sample = nullptr;
+			int capacity = CountEntities(entities, decl, &sample);
+
+			if (capacity > 0)
+			{
+				classes.push_back(decl);
+				samples.push_back(sample);
+				capacities.push_back(capacity);
+			}
+		}
+
+		writer.Write((uint32_t)classes.size());
+
+		for (int i = 0; i < classes.size(); i++)
+		{
+			writer.Write(classes[i]->GetName());
+			writer.Write(samples[i]->GetMetaData()->GetLayoutHash());
+			writer.Write((uint32_t)capacities[i]);
+		}
+
+		SaveEntities(writer, classes, entities);
+	}
+
+	void Scene::SaveEntities(BinaryWriter& writer, eastl::vector<ClassFactorySceneEntity*>& classes, eastl::vector<SceneEntity*>& entities)
+	{
+		writer.Write((uint32_t)entities.size());
+
+		for (auto entity : entities)
+		{
+			uint16_t classIndex = (uint16_t)(eastl::find(classes.begin(), classes.end(), entity->decl) - classes.begin());
+
+			writer.Write(classIndex);
+			writer.Write(entity->GetUID());
+
+			entity->Save(writer);
+
+			SaveEntities(writer, classes, entity->childs);
+		}
+	}
+	#endif
+
+	void Scene::LoadPools(JsonReader& reader)
+	{
+		// capacity hints are reserved before loading, so entities of a class are placed in one slab
+		while (reader.EnterBlock("pools"))
+		{
+			char type[512];
+			int capacity = 0;
+
+			reader.Read("type", type, 512);
+			reader.Read("capacity", capacity);
+
+			ClassFactorySceneEntity* decl = ClassFactorySceneEntity::Find(type);
+			ObjectPool* pool = decl ? decl->GetPool() : nullptr;
+
+			if (pool && capacity > 0)
+			{
+				pool->Reserve(capacity);
+			}
+
+			reader.LeaveBlock();
+		}
+	}
+
+	void Scene::SavePools(JsonWriter& writer)
+	{
+		writer.StartArray("pools");
+
+		for (auto decl : ClassFactorySceneEntity::Decls())
+		{
+			int capacity = CountEntities(entities, decl);
+
+			if (capacity == 0 || !decl->GetPool())
+			{
+				continue;
+			}
+
+			writer.StartBlock(nullptr);
+
+			writer.Write("type", decl->GetName());
+			writer.Write("capacity", capacity);
+
+			writer.FinishBlock();
+		}
+
+		writer.FinishArray();
+	}
+
+	int Scene::CountEntities(eastl::vector<SceneEntity*>& entities, ClassFactorySceneEntity* decl, SceneEntity** sample)
+	{
+		int count = 0;
+
+		for (auto entity : entities)
+		{
+			if (entity->decl == decl)
+			{
+				if (sample && !*sample)
+				{
+					*sample = entity;
+				}
+
+				count++;
+			}
+
+			count += CountEntities(entity->childs, decl, sample);
+		}
+
+		return count;
+	}
+
 	void Scene::Execute(float dt)
 	{
 		taskPool->Execute(dt);
@@ -328,7 +729,7 @@ namespace Oak
 
 	SceneEntity* Scene::FindInGroup(const char* groupName, const char* name)
 	{
-		eastl::vector<Group*> outGroups;
+		FrameVector<Group*> outGroups;
 
 		GetGroup(outGroups, groupName);
 
@@ -346,14 +747,6 @@ namespace Oak
 		return nullptr;
 	}
 
-	void Scene::GetGroup(eastl::vector<Group*>& outGroups, const char* name)
-	{
-		if (groups.find(name) != groups.end())
-		{
-			outGroups.push_back(&groups[name]);
-		}
-	}
-
 	void Scene::AddToGroup(SceneEntity* entity, const char* name)
 	{
 		Group& group = groups[name];
@@ -399,8 +792,18 @@ namespace Oak
 	{
 		Clear();
 
+		root.particles.ReleaseInstances(taskPool);
+
 		delete taskPool;
-		root.render.DelTaskPool(renderTaskPool);
+
+		if (renderPoolAttached)
+		{
+			root.render.DelTaskPool(renderTaskPool);
+		}
+		else
+		{
+			delete renderTaskPool;
+		}
 
 		delete this;
 	}
@@ -3,6 +3,7 @@
 
 #include "Root/TaskExecutor/TaskExecutor.h"
 #include "Root/Files/Files.h"
+#include "SpatialIndex.h"
 
 namespace Oak
 {
@@ -18,6 +19,7 @@ namespace Oak
 	*/
 
 	class SceneEntity;
+	class ClassFactorySceneEntity;
 
 	class CLASS_DECLSPEC Scene
 	{
@@ -33,6 +35,11 @@ namespace Oak
 			eastl::vector<SceneEntity*> entities;
 		};
 
+		/**
+		\brief Level of render tasks at which entities of a scene are culled by a camera
+		*/
+		constexpr static int cullingLevel = -10;
+
 	#ifndef DOXYGEN_SKIP
 
 	#ifdef OAK_EDITOR
@@ -42,6 +49,8 @@ namespace Oak
 		TaskExecutor::SingleTaskPool* taskPool = nullptr;
 		TaskExecutor::SingleTaskPool* renderTaskPool = nullptr;
 
+		SpatialIndex spatialIndex;
+
 	#endif
 
 	private:
@@ -68,16 +77,57 @@ namespace Oak
 		char scenePath[512];
 		char sceneName[512];
 
+		bool renderPoolAttached = false;
+
+		class Culler : public Object
+		{
+		public:
+			Scene* owner = nullptr;
+
+			void Execute(float dt);
+		};
+
+		Culler culler;
+
+		bool deferApply = false;
+		eastl::vector<SceneEntity*> pendingApply;
+		int pendingApplyIndex = 0;
+
+		static CriticalSection metaDataLock;
+
+		void ApplyLoadedEntities(eastl::vector<SceneEntity*>& entities);
+		void ApplyLoadedEntity(SceneEntity* entity);
+
 		void LoadEntities(JsonReader& reader, const char* name, eastl::vector<SceneEntity*>& entities);
 		void SaveEntities(JsonWriter& writer, const char* name, eastl::vector<SceneEntity*>& entities);
 
+		void LoadPools(JsonReader& reader);
+		void SavePools(JsonWriter& writer);
+		int CountEntities(eastl::vector<SceneEntity*>& entities, ClassFactorySceneEntity* decl, SceneEntity** sample = nullptr);
+
+		struct BinaryClass
+		{
+			ClassFactorySceneEntity* decl = nullptr;
+			uint32_t layoutHash = 0;
+			bool layoutChecked = false;
+		};
+
+		bool LoadEntities(BinaryReader& reader, eastl::vector<BinaryClass>& classes, eastl::vector<SceneEntity*>& entities);
+
+		#ifdef OAK_EDITOR
+		void SaveEntities(BinaryWriter& writer, eastl::vector<ClassFactorySceneEntity*>& classes, eastl::vector<SceneEntity*>& entities);
+		#endif
+
+		SceneEntity* CreateEntity(ClassFactorySceneEntity* decl, bool setNameAndUDID);
+
 	public:
 
 	#ifndef DOXYGEN_SKIP
 		Scene() = default;
 		virtual ~Scene() = default;
 
-		void Init();
+		void Init(bool attachRenderPool = true);
+		void AttachRenderPool();
 	
 		const char* GetPath();
 		const char* GetName();
@@ -85,6 +135,14 @@ namespace Oak
 		void Clear();
 		void Load(const char* name);
 		void Save(const char* name);
+		bool LoadBinary(const char* name);
+		#ifdef OAK_EDITOR
+		void SaveBinary(const char* name);
+		#endif
+		static void GetBinaryPath(const char* name, char* path, int len);
+		bool FinishLoading(double deadline);
+		float GetApplyProgress();
+		bool ReleaseEntities(double deadline);
 		void Execute(float dt);
 
 		bool Play();
@@ -152,7 +210,16 @@ namespace Oak
 		\param[in] name Name of a group
 
 		*/
-		void GetGroup(eastl::vector<Group*>& groups, const char* name);
+		template<typename Allocator>
+		void GetGroup(eastl::vector<Group*, Allocator>& outGroups, const char* name)
+		{
+			auto iter = groups.find(name);
+
+			if (iter != groups.end())
+			{
+				outGroups.push_back(&iter->second);
+			}
+		}
 
 		/**
 		\brief Adding a scene object to a group
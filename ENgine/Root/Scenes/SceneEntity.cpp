@@ -25,6 +25,8 @@ namespace Oak
 
 		scene->DelFromAllGroups(this, setScene);
 
+		scene->spatialIndex.Remove(&cullingEntry);
+
 		scene = setScene;
 		scene->AddEntity(this);
 	}
@@ -90,6 +92,16 @@ namespace Oak
 		return visible;
 	}
 
+	bool SceneEntity::IsCulled()
+	{
+		return !cullingEntry.IsVisible();
+	}
+
+	bool SceneEntity::UpdateBounds(const Math::Vector3& bbMin, const Math::Vector3& bbMax)
+	{
+		return scene ? scene->spatialIndex.SetBounds(&cullingEntry, bbMin, bbMax) : true;
+	}
+
 	Transform& SceneEntity::GetTransform()
 	{
 		return transform;
@@ -107,6 +119,20 @@ namespace Oak
 		GetMetaData()->Save(writer);
 	}
 
+	void SceneEntity::Load(BinaryReader& reader)
+	{
+		GetMetaData()->Prepare(this);
+		GetMetaData()->Load(reader);
+	}
+
+	#ifdef OAK_EDITOR
+	void SceneEntity::Save(BinaryWriter& writer)
+	{
+		GetMetaData()->Prepare(this);
+		GetMetaData()->Save(writer);
+	}
+	#endif
+
 	TaskExecutor::SingleTaskPool* SceneEntity::Tasks(bool render)
 	{
 		return render ? scene->renderTaskPool : scene->taskPool;
@@ -156,7 +182,19 @@ namespace Oak
 
 		if (scene) scene->DelFromAllGroups(this);
 
-		delete this;
+		if (cullingEntry.index)
+		{
+			cullingEntry.index->Remove(&cullingEntry);
+		}
+
+		if (decl)
+		{
+			decl->Destroy(this);
+		}
+		else
+		{
+			delete this;
+		}
 	}
 
 	void SceneEntity::SetParent(SceneEntity* setParent, SceneEntity* entityBefore)
@@ -11,6 +11,8 @@
 
 namespace Oak
 {
+	class ClassFactorySceneEntity;
+
 	/**
 	\ingroup gr_code_root_scene
 	*/
@@ -40,6 +42,20 @@ namespace Oak
 		SceneEntity* parent = nullptr;
 		eastl::vector<SceneEntity*> childs;
 
+		#ifndef DOXYGEN_SKIP
+		SpatialIndex::Entry cullingEntry;
+		#endif
+
+		/**
+		\brief Set bounds of an entity for culling. Entity without bounds is never culled.
+
+		\param[in] bbMin Minimal corner of bounds in world space
+		\param[in] bbMax Maximal corner of bounds in world space
+
+		\return True will be returned if entity with new bounds is visible by a camera
+		*/
+		bool UpdateBounds(const Math::Vector3& bbMin, const Math::Vector3& bbMax);
+
 	#ifdef OAK_EDITOR
 		bool edited = false;
 	#endif
@@ -52,6 +68,7 @@ namespace Oak
 
 		const char* className = nullptr;
 		const char* scriptClassName = nullptr;
+		ClassFactorySceneEntity* decl = nullptr;
 
 		SceneEntity() = default;
 		virtual ~SceneEntity() = default;
@@ -95,6 +112,13 @@ namespace Oak
 		*/
 		virtual bool IsVisible();
 
+		/**
+		\brief Check if entity is out of view of a camera in current frame
+
+		\return True will be returned if entity was culled
+		*/
+		bool IsCulled();
+
 		/**
 		\brief Get transformation of scene entity
 
@@ -121,6 +145,22 @@ namespace Oak
 		*/
 		virtual void Save(JsonWriter& writer);
 
+		/**
+		\brief Load properties from binary scene file
+
+		\param[in] reader Helper class for reading binary file
+		*/
+		virtual void Load(BinaryReader& reader);
+
+	#ifdef OAK_EDITOR
+		/**
+		\brief Save properties into binary scene file
+
+		\param[in] writer Helper class for writing binary file
+		*/
+		virtual void Save(BinaryWriter& writer);
+	#endif
+
 		/**
 		\brief Get task pool
 
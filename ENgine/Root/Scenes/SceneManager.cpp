@@ -1,6 +1,7 @@
 
 #include "Root/Scenes/SceneEntity.h"
 #include "Root/Root.h"
+#include "Support/Timer.h"
 
 namespace Oak
 {
@@ -80,25 +81,250 @@ namespace Oak
 
 		holder->refCounter++;
 
-		if (holder->scene)
+		if (holder->state != StreamState::Unloaded)
 		{
 			return;
 		}
 
-		holder->scene = new Scene();
-		holder->scene->Init();
+		holder->state = StreamState::Streaming;
 
-		char path[1024];
-		StringUtils::Printf(path, 1024, "%s%s", projectPath, holder->path.c_str());
+		if (!streaming.load(std::memory_order_acquire))
+		{
+			streaming.store(true, std::memory_order_release);
+
+			streamer.owner = this;
+			streamThread.Execute(&streamer, (ThreadCaller::Delegate)&Streamer::Work);
+		}
+
+		streamLock.Enter();
+		streamQueue.push_back(holder);
+		streamLock.UnLock();
+
+		streamSignal.Release(1);
+	}
+
+	void SceneManager::Streamer::Work()
+	{
+		owner->Stream();
+	}
+
+	void SceneManager::Stream()
+	{
+		while (true)
+		{
+			streamSignal.Wait();
+
+			if (!streaming.load(std::memory_order_acquire))
+			{
+				break;
+			}
+
+			while (true)
+			{
+				streamLock.Enter();
+
+				if (streamQueue.empty())
+				{
+					streamLock.UnLock();
+					break;
+				}
+
+				SceneHolder* holder = streamQueue.front();
+				streamQueue.erase(streamQueue.begin());
+
+				streamBusy.store(true, std::memory_order_relaxed);
+
+				streamLock.UnLock();
+
+				// render pool is attached on a main thread when scene is ready to play
+				Scene* scene = new Scene();
+				scene->Init(false);
+				scene->deferApply = true;
+
+				char path[1024];
+				StringUtils::Printf(path, 1024, "%s%s", projectPath, holder->path.c_str());
+
+				char binaryPath[1024];
+				Scene::GetBinaryPath(path, binaryPath, 1024);
+
+				if (!scene->LoadBinary(binaryPath))
+				{
+					scene->Load(path);
+				}
+
+				streamLock.Enter();
+
+				holder->staging = scene;
+				streamedScenes.push_back(holder);
+
+				streamBusy.store(false, std::memory_order_relaxed);
+
+				streamLock.UnLock();
+			}
+		}
+	}
+
+	void SceneManager::StopStreaming()
+	{
+		if (streaming.load(std::memory_order_acquire))
+		{
+			streaming.store(false, std::memory_order_release);
+			streamSignal.Release(1);
+
+			while (streamThread.IsExecuting())
+			{
+				ThreadExecutor::Sleep(1);
+			}
+		}
+
+		for (auto* holder : streamQueue)
+		{
+			holder->state = StreamState::Unloaded;
+		}
+
+		streamQueue.clear();
+
+		finishingScenes.insert(finishingScenes.end(), streamedScenes.begin(), streamedScenes.end());
+		streamedScenes.clear();
+
+		for (auto* holder : finishingScenes)
+		{
+			RELEASE(holder->staging)
+			holder->state = StreamState::Unloaded;
+		}
+
+		finishingScenes.clear();
+
+		for (auto* scene : unloadingScenes)
+		{
+			scene->Release();
+			root.sounds.DeleteSceneSounds(scene);
+		}
+
+		unloadingScenes.clear();
+	}
+
+	void SceneManager::FinishStreaming(double deadline)
+	{
+		streamLock.Enter();
+
+		for (auto* holder : streamedScenes)
+		{
+			holder->state = StreamState::Finishing;
+			finishingScenes.push_back(holder);
+		}
+
+		streamedScenes.clear();
+
+		streamLock.UnLock();
 
-		holder->scene->Load(path);
+		// assets requested by a streaming thread are loaded first as entities are using them in ApplyProperties
+		if (!root.assets.LoadPendingAssets(deadline))
+		{
+			return;
+		}
 
-		if (!holder->scene->Play())
+		while (finishingScenes.size() > 0)
 		{
-			failureOnScenePlay = true;
+			SceneHolder* holder = finishingScenes.front();
+
+			if (holder->refCounter == 0)
+			{
+				unloadingScenes.push_back(holder->staging);
+			}
+			else
+			{
+				if (!holder->staging->FinishLoading(deadline))
+				{
+					break;
+				}
+
+				holder->scene = holder->staging;
+				holder->scene->AttachRenderPool();
+
+				if (!holder->scene->Play())
+				{
+					failureOnScenePlay = true;
+				}
+			}
+
+			holder->staging = nullptr;
+			holder->state = holder->scene ? StreamState::Loaded : StreamState::Unloaded;
+
+			finishingScenes.erase(finishingScenes.begin());
+
+			if (Timer::GetTime() > deadline)
+			{
+				break;
+			}
+		}
+	}
+
+	void SceneManager::FinishUnloading(double deadline)
+	{
+		while (unloadingScenes.size() > 0)
+		{
+			Scene* scene = unloadingScenes.front();
+
+			if (!scene->ReleaseEntities(deadline))
+			{
+				break;
+			}
+
+			unloadingScenes.erase(unloadingScenes.begin());
+
+			scene->Release();
+			root.sounds.DeleteSceneSounds(scene);
 		}
 	}
 
+	float SceneManager::GetLoadingProgress(const char* name)
+	{
+		auto iter = scenesSearch.find(name);
+
+		if (iter == scenesSearch.end())
+		{
+			return 1.0f;
+		}
+
+		SceneHolder* holder = iter->second;
+
+		if (holder->state == StreamState::Finishing)
+		{
+			return 0.5f + 0.5f * holder->staging->GetApplyProgress();
+		}
+
+		if (holder->state == StreamState::Streaming || eastl::find(scenesToLoad.begin(), scenesToLoad.end(), holder) != scenesToLoad.end())
+		{
+			return 0.0f;
+		}
+
+		return 1.0f;
+	}
+
+	bool SceneManager::IsStreaming()
+	{
+		if (scenesToLoad.size() > 0 || finishingScenes.size() > 0 || unloadingScenes.size() > 0)
+		{
+			return true;
+		}
+
+		for (auto& scn : scenes)
+		{
+			if (scn.state == StreamState::Streaming)
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	void SceneManager::SetStreamingBudget(double budget)
+	{
+		streamBudget = budget;
+	}
+
 	Scene* SceneManager::GetScene(const char* name)
 	{
 		if (scenesSearch.find(name) == scenesSearch.end())
@@ -125,6 +351,11 @@ namespace Oak
 
 		scenesToDelete.clear();
 
+		double deadline = Timer::GetTime() + streamBudget;
+
+		FinishStreaming(deadline);
+		FinishUnloading(deadline);
+
 		for (int i = 0; i < scenes.size(); i++)
 		{
 			auto& scn = scenes[i];
@@ -145,7 +376,7 @@ namespace Oak
 		{
 			if (scn.scene)
 			{
-				eastl::vector<Scene::Group*> outGroup;
+				FrameVector<Scene::Group*> outGroup;
 				scn.scene->GetGroup(outGroup, groupName);
 
 				for (auto group : outGroup)
@@ -181,11 +412,14 @@ namespace Oak
 
 	void SceneManager::UnloadScene(SceneHolder* holder)
 	{
-		if (holder->refCounter == 0)
+		// entities are released on next frames within streaming budget
+		if (holder->refCounter == 0 && holder->scene)
 		{
-			auto* scene = holder->scene;
-			RELEASE(holder->scene)
-			root.sounds.DeleteSceneSounds(scene);
+			holder->scene->EnableTasks(false);
+			unloadingScenes.push_back(holder->scene);
+
+			holder->scene = nullptr;
+			holder->state = StreamState::Unloaded;
 		}
 	}
 
@@ -194,6 +428,8 @@ namespace Oak
 		failureOnScenePlay = false;
 		failureOnScenePlayMessage.clear();
 
+		StopStreaming();
+
 		for (auto& scn : scenes)
 		{
 			if (scn.scene)
@@ -2,6 +2,8 @@
 #pragma once
 
 #include "Scene.h"
+#include "Support/ThreadExecutor.h"
+#include <atomic>
 
 namespace Oak
 {
@@ -15,18 +17,30 @@ namespace Oak
 
 	This manager handles loading and unloading scenes according data from a project.
 	Scenes in a project have different pathes but to load/unload scene a file name without
-	extenstion is needed.
+	extenstion is needed. Scenes are streamed: reading of a file and creation of entities
+	are done on a loading thread, loading of assets, applying of properties and releasing
+	of entities are done on a main thread within time budget per frame.
 	*/
 
 	class CLASS_DECLSPEC SceneManager : public Object
 	{
 		friend class SceneEntity;
 
+		enum class StreamState
+		{
+			Unloaded,
+			Streaming,
+			Finishing,
+			Loaded
+		};
+
 		struct SceneHolder
 		{
 			eastl::string path;
 			Scene* scene = nullptr;
 			int refCounter = 0;
+			StreamState state = StreamState::Unloaded;
+			Scene* staging = nullptr;
 		};
 
 		char projectPath[1024];
@@ -40,8 +54,34 @@ namespace Oak
 
 		eastl::map<eastl::string, SceneHolder*> scenesSearch;
 
+		class Streamer : public ThreadCaller
+		{
+		public:
+			SceneManager* owner = nullptr;
+
+			void Work();
+		};
+
+		Streamer streamer;
+		ThreadExecutor streamThread;
+		ThreadSemaphore streamSignal;
+		CriticalSection streamLock;
+		std::atomic<bool> streaming{ false };
+		std::atomic<bool> streamBusy{ false };
+
+		eastl::vector<SceneHolder*> streamQueue;
+		eastl::vector<SceneHolder*> streamedScenes;
+		eastl::vector<SceneHolder*> finishingScenes;
+		eastl::vector<Scene*> unloadingScenes;
+
+		double streamBudget = 0.004;
+
 		void LoadScene(SceneHolder* holder);
 		void UnloadScene(SceneHolder* holder);
+		void Stream();
+		void StopStreaming();
+		void FinishStreaming(double deadline);
+		void FinishUnloading(double deadline);
 
 	public:
 
@@ -64,12 +104,35 @@ namespace Oak
 		void LoadScene(const char* name);
 
 		/**
-		\brief Get a scene
+		\brief Get a scene. Scene is returned only after streaming of a scene was finished.
 
 		\param[in] name Name of a scene (filename without extension)
 		*/
 		Scene* GetScene(const char* name);
 
+		/**
+		\brief Get progress of loading of a scene
+
+		\param[in] name Name of a scene (filename without extension)
+
+		\return Value in range [0..1]. 1 means that scene is loaded and playing or scene is not requested to be loaded.
+		*/
+		float GetLoadingProgress(const char* name);
+
+		/**
+		\brief Check if some scene is streaming or unloading right now
+
+		\return True will be returned if some scene is streaming or unloading
+		*/
+		bool IsStreaming();
+
+		/**
+		\brief Set time budget of main thread per frame which is spent on finishing of loading and on unloading of scenes
+
+		\param[in] budget Time in seconds
+		*/
+		void SetStreamingBudget(double budget);
+
 		/**
 		\brief Set visibility for scene objects from scene groups in all loaded scenes
 
@@ -0,0 +1,242 @@
+#include "SpatialIndex.h"
+
+namespace Oak
+{
+	bool SpatialIndex::Entry::IsVisible() const
+	{
+		return !index || !index->culled || visibleFrame == index->frame;
+	}
+
+	uint64_t SpatialIndex::GetKey(int x, int y, int z)
+	{
+		const uint64_t mask = (1 << 21) - 1;
+
+		return ((uint64_t)(x + maxCell) & mask) | (((uint64_t)(y + maxCell) & mask) << 21) | (((uint64_t)(z + maxCell) & mask) << 42);
+	}
+
+	float SpatialIndex::GetCellSize(int level)
+	{
+		return minCellSize * (float)(1 << level);
+	}
+
+	void SpatialIndex::GetPlace(const Math::Vector3& bbMin, const Math::Vector3& bbMax, int& level, int* cell)
+	{
+		Math::Vector3 size = bbMax - bbMin;
+		float maxSize = fmaxf(size.x, fmaxf(size.y, size.z));
+
+		level = 0;
+
+		while (level < levelsCount && GetCellSize(level) < maxSize)
+		{
+			level++;
+		}
+
+		if (level == levelsCount)
+		{
+			return;
+		}
+
+		float cellSize = GetCellSize(level);
+
+		for (int i = 0; i < 3; i++)
+		{
+			float center = (bbMin.v[i] + bbMax.v[i]) * 0.5f;
+			cell[i] = (int)Math::Clamp(floorf(center / cellSize), (float)-maxCell, (float)(maxCell - 1));
+		}
+	}
+
+	void SpatialIndex::Insert(Entry* entry)
+	{
+		GetPlace(entry->bbMin, entry->bbMax, entry->level, entry->cell);
+
+		if (entry->level == levelsCount)
+		{
+			entry->indexInNode = (int)oversized.size();
+			oversized.push_back(entry);
+
+			return;
+		}
+
+		for (int level = entry->level; level < levelsCount; level++)
+		{
+			int shift = level - entry->level;
+			int x = entry->cell[0] >> shift;
+			int y = entry->cell[1] >> shift;
+			int z = entry->cell[2] >> shift;
+
+			Node& node = nodes[level][GetKey(x, y, z)];
+			node.cell[0] = x;
+			node.cell[1] = y;
+			node.cell[2] = z;
+			node.count++;
+
+			if (level == entry->level)
+			{
+				entry->indexInNode = (int)node.entries.size();
+				node.entries.push_back(entry);
+			}
+		}
+	}
+
+	void SpatialIndex::Erase(Entry* entry)
+	{
+		if (entry->level == levelsCount)
+		{
+			oversized[entry->indexInNode] = oversized.back();
+			oversized[entry->indexInNode]->indexInNode = entry->indexInNode;
+			oversized.pop_back();
+
+			return;
+		}
+
+		for (int level = entry->level; level < levelsCount; level++)
+		{
+			int shift = level - entry->level;
+			auto iter = nodes[level].find(GetKey(entry->cell[0] >> shift, entry->cell[1] >> shift, entry->cell[2] >> shift));
+
+			Node& node = iter->second;
+
+			if (level == entry->level)
+			{
+				node.entries[entry->indexInNode] = node.entries.back();
+				node.entries[entry->indexInNode]->indexInNode = entry->indexInNode;
+				node.entries.pop_back();
+			}
+
+			node.count--;
+
+			if (node.count == 0)
+			{
+				nodes[level].erase(iter);
+			}
+		}
+	}
+
+	bool SpatialIndex::SetBounds(Entry* entry, const Math::Vector3& bbMin, const Math::Vector3& bbMax)
+	{
+		if (entry->index == this && memcmp(&entry->bbMin, &bbMin, sizeof(Math::Vector3)) == 0 && memcmp(&entry->bbMax, &bbMax, sizeof(Math::Vector3)) == 0)
+		{
+			return entry->IsVisible();
+		}
+
+		if (entry->index && entry->index != this)
+		{
+			entry->index->Remove(entry);
+		}
+
+		lock.Enter();
+
+		int level;
+		int cell[3];
+		GetPlace(bbMin, bbMax, level, cell);
+
+		bool moved = entry->index != this || level != entry->level || (level != levelsCount && memcmp(cell, entry->cell, sizeof(cell)) != 0);
+
+		if (moved && entry->index == this)
+		{
+			Erase(entry);
+		}
+
+		entry->index = this;
+		entry->bbMin = bbMin;
+		entry->bbMax = bbMax;
+
+		if (moved)
+		{
+			Insert(entry);
+		}
+
+		// entry was changed after culling, so it is checked right away
+		entry->visibleFrame = frustum.IsBoxVisible(bbMin, bbMax) ? frame : frame - 1;
+
+		lock.UnLock();
+
+		return entry->IsVisible();
+	}
+
+	void SpatialIndex::Remove(Entry* entry)
+	{
+		if (entry->index != this)
+		{
+			return;
+		}
+
+		lock.Enter();
+
+		Erase(entry);
+		entry->index = nullptr;
+		entry->level = -1;
+		entry->indexInNode = -1;
+
+		lock.UnLock();
+	}
+
+	void SpatialIndex::CullNode(int level, Node& node, bool inside)
+	{
+		if (!inside)
+		{
+			float cellSize = GetCellSize(level);
+
+			Math::Vector3 bbMin(((float)node.cell[0] - 0.5f) * cellSize, ((float)node.cell[1] - 0.5f) * cellSize, ((float)node.cell[2] - 0.5f) * cellSize);
+			Math::Vector3 bbMax(((float)node.cell[0] + 1.5f) * cellSize, ((float)node.cell[1] + 1.5f) * cellSize, ((float)node.cell[2] + 1.5f) * cellSize);
+
+			Math::Frustum::Result result = frustum.CheckBox(bbMin, bbMax);
+
+			if (result == Math::Frustum::Result::Outside)
+			{
+				return;
+			}
+
+			inside = (result == Math::Frustum::Result::Inside);
+		}
+
+		for (auto* entry : node.entries)
+		{
+			if (inside || frustum.IsBoxVisible(entry->bbMin, entry->bbMax))
+			{
+				entry->visibleFrame = frame;
+			}
+		}
+
+		if (level == 0 || node.count == (int)node.entries.size())
+		{
+			return;
+		}
+
+		auto& children = nodes[level - 1];
+
+		for (int i = 0; i < 8; i++)
+		{
+			auto iter = children.find(GetKey(node.cell[0] * 2 + (i & 1), node.cell[1] * 2 + ((i >> 1) & 1), node.cell[2] * 2 + ((i >> 2) & 1)));
+
+			if (iter != children.end())
+			{
+				CullNode(level - 1, iter->second, inside);
+			}
+		}
+	}
+
+	void SpatialIndex::Cull(const Math::Matrix& viewProj)
+	{
+		lock.Enter();
+
+		frustum.Build(viewProj);
+		frame++;
+		culled = true;
+
+		for (auto* entry : oversized)
+		{
+			if (frustum.IsBoxVisible(entry->bbMin, entry->bbMax))
+			{
+				entry->visibleFrame = frame;
+			}
+		}
+
+		for (auto& iter : nodes[levelsCount - 1])
+		{
+			CullNode(levelsCount - 1, iter.second, false);
+		}
+
+		lock.UnLock();
+	}
+}
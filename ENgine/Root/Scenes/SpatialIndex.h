@@ -0,0 +1,111 @@
+#pragma once
+
+#include "Support/Support.h"
+#include "Support/ThreadExecutor.h"
+#include <eastl/hash_map.h>
+
+namespace Oak
+{
+	/**
+	\ingroup gr_code_root_scene
+	*/
+
+	/**
+	\brief SpatialIndex
+
+	This is a loose octree which keeps bounds of scene entities. Nodes are stored in a hash map per level,
+	so octree has no fixed size and nodes exist only where entities are. Entry is placed into a node of
+	the lowest level which cell isn't smaller than an entry, bounds of a node are twice bigger than a cell.
+	Entities of 2D layers are lying in one slab along Z, so for them octree works as a loose quadtree.
+	Culling walks from top level and skips subtrees which are outside of a frustum, entries of subtrees
+	which are fully inside of a frustum are marked visible without tests.
+
+	*/
+
+	class CLASS_DECLSPEC SpatialIndex
+	{
+	public:
+
+		/**
+		\brief Entry of an index. Entry is stored inside of an owner, index keeps only pointer to it.
+		*/
+		struct Entry
+		{
+			#ifndef DOXYGEN_SKIP
+			SpatialIndex* index = nullptr;
+			Math::Vector3 bbMin;
+			Math::Vector3 bbMax;
+			int level = -1;
+			int cell[3] = { 0, 0, 0 };
+			int indexInNode = -1;
+			uint32_t visibleFrame = 0;
+			#endif
+
+			/**
+			\brief Check if entry was visible during last culling. Entry which isn't added into an index is always visible.
+
+			\return True will be returned if entry is visible
+			*/
+			bool IsVisible() const;
+		};
+
+	private:
+
+		#ifndef DOXYGEN_SKIP
+
+		constexpr static int levelsCount = 16;
+		constexpr static float minCellSize = 1.0f;
+		constexpr static int maxCell = 1 << 20;
+
+		struct Node
+		{
+			int cell[3];
+			int count = 0;
+			eastl::vector<Entry*> entries;
+		};
+
+		eastl::hash_map<uint64_t, Node> nodes[levelsCount];
+		eastl::vector<Entry*> oversized;
+		Math::Frustum frustum;
+		uint32_t frame = 0;
+		bool culled = false;
+		CriticalSection lock;
+
+		static uint64_t GetKey(int x, int y, int z);
+		static float GetCellSize(int level);
+		static void GetPlace(const Math::Vector3& bbMin, const Math::Vector3& bbMax, int& level, int* cell);
+
+		void Insert(Entry* entry);
+		void Erase(Entry* entry);
+		void CullNode(int level, Node& node, bool inside);
+
+		#endif
+
+	public:
+
+		/**
+		\brief Set bounds of an entry. Entry is added into an index on first call.
+
+		\param[in] entry Pointer to an entry
+		\param[in] bbMin Minimal corner of bounds in world space
+		\param[in] bbMax Maximal corner of bounds in world space
+
+		\return True will be returned if entry with new bounds is visible for a frustum of last culling
+		*/
+		bool SetBounds(Entry* entry, const Math::Vector3& bbMin, const Math::Vector3& bbMax);
+
+		/**
+		\brief Remove an entry from an index
+
+		\param[in] entry Pointer to an entry
+		*/
+		void Remove(Entry* entry);
+
+		/**
+		\brief Mark entries which are visible for a camera
+
+		\param[in] viewProj View projection matrix of a camera
+		*/
+		void Cull(const Math::Matrix& viewProj);
+	};
+}
@@ -199,15 +199,10 @@ namespace Oak
 
 		if (scene)
 		{
-			auto* system = core.particles.LoadParticle(name.c_str(), scene->taskPool, scene->renderTaskPool, true);
+			Matrix mat;
+			mat.Pos() = pos;
 
-			if (system)
-			{
-				Matrix mat;
-				mat.Pos() = pos;
-
-				system->SetTransform(mat);
-			}
+			core.particles.Spawn(name.c_str(), scene->taskPool, scene->renderTaskPool, mat);
 		}
 	}
 
@@ -223,6 +218,11 @@ namespace Oak
 		return nullptr;
 	}
 
+	void ScriptCore::Scene::PreloadParticles(string& name)
+	{
+		core.particles.Preload(name.c_str());
+	}
+
 	void ScriptCore_Scene_Raycast2D(asIScriptGeneric *gen)
 	{
 		ScriptCore::Scene* scene = (ScriptCore::Scene*)gen->GetObject();
@@ -426,6 +426,7 @@ namespace Oak
 		core.scripts.RegisterObjectMethod(script_class_name, "void CallClassInstancesMethod(string&in scene_name, string&in class_name, string&in method)", WRAP_MFN(ScriptCore::Scene, CallClassInstancesMethod), "Call methos in instances of script classes");
 		core.scripts.RegisterObjectMethod(script_class_name, "void PlayParticles(string&in scene_name, string&in name, Vector3&in pos)", WRAP_MFN(ScriptCore::Scene, PlayParticles), "Create particle instance in particular point");
 		core.scripts.RegisterObjectMethod(script_class_name, "ParticleSystem@ CreateParticles(string&in scene_name, string&in name)", WRAP_MFN(ScriptCore::Scene, CreateParticles), "Create instance of particle system");
+		core.scripts.RegisterObjectMethod(script_class_name, "void PreloadParticles(string&in name)", WRAP_MFN(ScriptCore::Scene, PreloadParticles), "Start loading of particle system in background");
 
 		script_class_name = "SoundInstance";
 		core.scripts.RegisterObjectType(script_class_name, sizeof(SoundInstance), "gr_script_core", "Script sound instance");
@@ -47,6 +47,7 @@ namespace Oak
 			void CallClassInstancesMethod(string& scene_name, string& class_name, string& method);
 			void PlayParticles(string& scen_name, string& name, Vector3& pos);
 			class ParticleSystem* CreateParticles(string& scen_name, string& name);
+			void PreloadParticles(string& name);
 		};
 
 		class Sound
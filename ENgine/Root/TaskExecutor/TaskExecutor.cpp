@@ -1,8 +1,17 @@
 
 #include "TaskExecutor.h"
+#include "Root/Root.h"
 
 namespace Oak
 {
+	void TaskExecutor::SingleTaskPool::ListJob::Execute(int from, int to)
+	{
+		for (int i = from; i < to; i++)
+		{
+			ExecuteTask(tasks[i], dt);
+		}
+	}
+
 	TaskExecutor::SingleTaskPool::~SingleTaskPool()
 	{
 		for (int j = 0; j < lists.size(); j++)
@@ -16,32 +25,155 @@ namespace Oak
 		active = set;
 	}
 
-	void TaskExecutor::SingleTaskPool::ExecuteList(TaskList* list, float dt)
+	void TaskExecutor::SingleTaskPool::SetLevelParallel(int level, bool set)
 	{
-		for (int j = 0; j<list->list.size(); j++)
+		GetTaskList(level)->parallel = set;
+	}
+
+	void TaskExecutor::SingleTaskPool::PushTask(TaskList* list, const Task& task)
+	{
+		if (list->indices.find(task.entity) == list->indices.end())
 		{
-			if (list->list[j].freq > 0.0f)
+			list->indices[task.entity] = (int)list->list.size();
+		}
+		else
+		{
+			list->hasDuplicates = true;
+		}
+
+		list->list.push_back(task);
+	}
+
+	void TaskExecutor::SingleTaskPool::CompactList(TaskList* list)
+	{
+		int count = 0;
+		bool hasDuplicates = false;
+
+		for (int i = 0; i < list->list.size(); i++)
+		{
+			Task& task = list->list[i];
+
+			if (!task.entity)
 			{
-				list->list[j].time -= dt;
+				continue;
+			}
 
+			// duplicates are searched again, as entity which had them could be deleted
+			if (count != i || list->hasDuplicates)
+			{
+				auto iter = list->indices.find(task.entity);
 
-				if (list->list[j].time > 0.0f)
+				if (iter != list->indices.end() && iter->second == i)
+				{
+					iter->second = count;
+				}
+				else
 				{
-					continue;
+					hasDuplicates = true;
 				}
 
-				list->list[j].time += list->list[j].freq;
+				list->list[count] = task;
+			}
+
+			count++;
+		}
+
+		list->list.resize(count);
+		list->deleted = 0;
+		list->hasDuplicates = hasDuplicates;
+	}
+
+	void TaskExecutor::SingleTaskPool::BeginList(TaskList* list)
+	{
+		if (list->deleted > 0)
+		{
+			CompactList(list);
+		}
+
+		list->executing = true;
+	}
+
+	void TaskExecutor::SingleTaskPool::EndList(TaskList* list)
+	{
+		list->executing = false;
+
+		for (auto& task : list->pending)
+		{
+			PushTask(list, task);
+		}
+
+		list->pending.clear();
+	}
+
+	void TaskExecutor::SingleTaskPool::ExecuteTask(Task& task, float dt)
+	{
+		if (!task.entity)
+		{
+			return;
+		}
+
+		if (task.freq > 0.0f)
+		{
+			task.time -= dt;
+
+			if (task.time > 0.0f)
+			{
+				return;
 			}
 
-			(list->list[j].entity->*list->list[j].call)(dt);
+			task.time += task.freq;
+		}
+
+		(task.entity->*task.call)(dt);
+	}
+
+	void TaskExecutor::SingleTaskPool::ExecuteList(TaskList* list, float dt)
+	{
+		BeginList(list);
+
+		if (list->parallel && list->list.size() > 1)
+		{
+			ListJob job;
+			job.tasks = list->list.data();
+			job.dt = dt;
+
+			root.taskExecutor.ExecuteParallel(&job, (int)list->list.size());
+		}
+		else
+		{
+			for (int j = 0; j<list->list.size(); j++)
+			{
+				ExecuteTask(list->list[j], dt);
+			}
 		}
+
+		EndList(list);
 	}
 
 	void TaskExecutor::SingleTaskPool::Execute(float dt)
 	{
-		for (int i = 0; i<lists.size(); i++)
+		if (lists.size() == 0)
 		{
-			ExecuteList(lists[i], dt);
+			return;
+		}
+
+		TaskList* list = lists[0];
+
+		while (list)
+		{
+			ExecuteList(list, dt);
+
+			int level = list->level;
+			list = nullptr;
+
+			for (int i = 0; i < lists.size(); i++)
+			{
+				if (lists[i]->level > level)
+				{
+					list = lists[i];
+					break;
+				}
+			}
 		}
 	}
 
@@ -58,7 +190,7 @@ namespace Oak
 		return nullptr;
 	}
 
-	void TaskExecutor::SingleTaskPool::AddTask(int level, Object* entity, Object::Delegate call, float freq)
+	TaskExecutor::SingleTaskPool::TaskList* TaskExecutor::SingleTaskPool::GetTaskList(int level)
 	{
 		TaskList* list = FindTaskList(level);
 
@@ -70,7 +202,7 @@ namespace Oak
 
 			int index = (int)lists.size() - 1;
 
-			while (index>0 && list[index - 1].level > list->level)
+			while (index>0 && lists[index - 1]->level > list->level)
 			{
 				TaskList* tmp = lists[index];
 				lists[index] = lists[index - 1];
@@ -78,21 +210,33 @@ namespace Oak
 
 				index--;
 			}
+
+			if (group)
+			{
+				group->AddList(this, list);
+			}
 		}
 
-		list->list.push_back(Task());
-		Task* delegate = &list->list[list->list.size() - 1];
+		return list;
+	}
 
-		delegate->entity = entity;
-		delegate->call = call;
-		delegate->freq = freq;
-		delegate->time = -1.0f;
+	void TaskExecutor::SingleTaskPool::AddTask(int level, Object* entity, Object::Delegate call, float freq)
+	{
+		TaskList* list = GetTaskList(level);
 
-		changeMark++;
+		Task task;
+		task.entity = entity;
+		task.call = call;
+		task.freq = freq;
+		task.time = -1.0f;
 
-		if (changeMark > 1000000)
+		if (list->executing)
+		{
+			list->pending.push_back(task);
+		}
+		else
 		{
-			changeMark = 0;
+			PushTask(list, task);
 		}
 	}
 
@@ -100,26 +244,50 @@ namespace Oak
 	{
 		TaskList* list = FindTaskList(level);
 
-		if (list)
+		if (!list)
 		{
-			for (int i = 0; i<list->list.size(); i++)
+			return;
+		}
+
+		for (int i = 0; i < list->pending.size(); i++)
+		{
+			if (entity == list->pending[i].entity)
 			{
-				if (entity == list->list[i].entity)
+				if (new_pool)
 				{
-					if (new_pool)
-					{
-						new_pool->AddTask(list->level, list->list[i].entity, list->list[i].call, list->list[i].freq);
-					}
-
-					list->list.erase(list->list.begin() + i);
-					i--;
+					new_pool->AddTask(list->level, entity, list->pending[i].call, list->pending[i].freq);
 				}
+
+				list->pending.erase(list->pending.begin() + i);
+				i--;
 			}
+		}
+
+		auto iter = list->indices.find(entity);
+
+		if (iter == list->indices.end())
+		{
+			return;
+		}
+
+		int from = iter->second;
+		int to = list->hasDuplicates ? (int)list->list.size() : from + 1;
+
+		list->indices.erase(iter);
+
+		for (int i = from; i < to; i++)
+		{
+			Task& task = list->list[i];
 
-			changeMark++;
-			if (changeMark > 1000000)
+			if (entity == task.entity)
 			{
-				changeMark = 0;
+				if (new_pool)
+				{
+					new_pool->AddTask(list->level, entity, task.call, task.freq);
+				}
+
+				task.entity = nullptr;
+				list->deleted++;
 			}
 		}
 	}
@@ -132,59 +300,117 @@ namespace Oak
 		}
 	}
 
-	void TaskExecutor::GroupTaskPool::FillList()
+	void TaskExecutor::GroupTaskPool::GroupJob::Execute(int from, int to)
 	{
-		groupLists.clear();
+		for (int i = from; i < to; i++)
+		{
+			SingleTaskPool::ExecuteTask(*tasks[i], dt);
+		}
+	}
 
-		for (int i = 0; i < taskPools.size(); i++)
+	TaskExecutor::GroupTaskPool::GroupList* TaskExecutor::GroupTaskPool::FindGroupList(int level)
+	{
+		auto iter = eastl::lower_bound(groupLists.begin(), groupLists.end(), level, [](const GroupList& groupList, int level) { return groupList.level < level; });
+
+		if (iter != groupLists.end() && iter->level == level)
 		{
-			SingleTaskPool* taskPool = taskPools[i];
+			return iter;
+		}
 
-			for (int j = 0; j < taskPool->lists.size(); j++)
-			{
-				SingleTaskPool::TaskList* taskList = taskPool->lists[j];
+		return nullptr;
+	}
 
-				GroupList* groupList = nullptr;
+	void TaskExecutor::GroupTaskPool::AddList(SingleTaskPool* pool, SingleTaskPool::TaskList* list)
+	{
+		if (executing)
+		{
+			TaskList taskList;
+			taskList.pool = pool;
+			taskList.list = list;
 
-				for (int l = 0; l < groupLists.size(); l++)
-				{
-					if (groupLists[l].level == taskList->level)
-					{
-						groupList = &groupLists[l];
+			pendingLists.push_back(taskList);
 
-						break;
-					}
-				}
+			return;
+		}
 
-				if (!groupList)
-				{
-					groupLists.push_back(GroupList());
-					groupList = &groupLists[groupLists.size() - 1];
-					groupList->level = taskList->level;
+		InsertList(pool, list);
+	}
 
-					int index = (int)groupLists.size() - 1;
+	void TaskExecutor::GroupTaskPool::ApplyPendingLists()
+	{
+		for (auto& taskList : pendingLists)
+		{
+			InsertList(taskList.pool, taskList.list);
+		}
 
-					while (index>0 && groupLists[index - 1].level > groupList->level)
-					{
-						GroupList tmp = groupLists[index];
-						groupLists[index] = groupLists[index - 1];
-						groupLists[index - 1] = tmp;
+		pendingLists.clear();
+	}
 
-						groupList = &groupLists[index - 1];
+	void TaskExecutor::GroupTaskPool::InsertList(SingleTaskPool* pool, SingleTaskPool::TaskList* list)
+	{
+		auto iter = eastl::lower_bound(groupLists.begin(), groupLists.end(), list->level, [](const GroupList& groupList, int level) { return groupList.level < level; });
 
-						index--;
-					}
-				}
+		if (iter == groupLists.end() || iter->level != list->level)
+		{
+			iter = groupLists.insert(iter, GroupList());
+			iter->level = list->level;
+			iter->parallel = eastl::find(parallelLevels.begin(), parallelLevels.end(), list->level) != parallelLevels.end();
+		}
 
-				groupList->taskLists.push_back(TaskList());
+		auto& taskLists = iter->taskLists;
 
-				TaskList& list = groupList->taskLists[groupList->taskLists.size() - 1];
-				list.pool = taskPool;
-				list.list = taskList;
+		int index = (int)taskLists.size();
+
+		while (index > 0 && taskLists[index - 1].pool->groupOrder > pool->groupOrder)
+		{
+			index--;
+		}
+
+		TaskList taskList;
+		taskList.pool = pool;
+		taskList.list = list;
+
+		taskLists.insert(taskLists.begin() + index, taskList);
+	}
+
+	void TaskExecutor::GroupTaskPool::DelLists(SingleTaskPool* pool)
+	{
+		for (int i = 0; i < pendingLists.size(); i++)
+		{
+			if (pendingLists[i].pool == pool)
+			{
+				pendingLists.erase(pendingLists.begin() + i);
+				i--;
+			}
+		}
+
+		for (int i = 0; i < groupLists.size(); i++)
+		{
+			auto& taskLists = groupLists[i].taskLists;
+
+			for (int j = 0; j < taskLists.size(); j++)
+			{
+				if (taskLists[j].pool == pool)
+				{
+					taskLists.erase(taskLists.begin() + j);
+					break;
+				}
+			}
+
+			if (taskLists.size() == 0)
+			{
+				groupLists.erase(groupLists.begin() + i);
+				i--;
 			}
 		}
 	}
 
+	void TaskExecutor::GroupTaskPool::SetLevelFinishedCallback(Object* entity, Object::Delegate call)
+	{
+		levelFinished.entity = entity;
+		levelFinished.call = call;
+	}
+
 	void TaskExecutor::GroupTaskPool::AddFilter(int level)
 	{
 		for (int i = 0; i < filter.size(); i++)
@@ -209,12 +435,45 @@ namespace Oak
 		}
 	}
 
+	void TaskExecutor::GroupTaskPool::SetLevelParallel(int level, bool set)
+	{
+		auto iter = eastl::find(parallelLevels.begin(), parallelLevels.end(), level);
+
+		if (set && iter == parallelLevels.end())
+		{
+			parallelLevels.push_back(level);
+		}
+		else
+		if (!set && iter != parallelLevels.end())
+		{
+			parallelLevels.erase(iter);
+		}
+
+		GroupList* groupList = FindGroupList(level);
+
+		if (groupList)
+		{
+			groupList->parallel = set;
+		}
+	}
+
 	TaskExecutor::SingleTaskPool* TaskExecutor::GroupTaskPool::AddTaskPool(const char* file, int line)
 	{
-		SingleTaskPool* pool = new(file, line) SingleTaskPool();
+		return AttachTaskPool(new(file, line) SingleTaskPool());
+	}
+
+	TaskExecutor::SingleTaskPool* TaskExecutor::GroupTaskPool::AttachTaskPool(SingleTaskPool* pool)
+	{
+		pool->group = this;
+		pool->groupOrder = poolsCounter++;
 
 		taskPools.push_back(pool);
 
+		for (auto* list : pool->lists)
+		{
+			AddList(pool, list);
+		}
+
 		return pool;
 	}
 
@@ -225,6 +484,7 @@ namespace Oak
 			if (taskPools[i] == pool)
 			{
 				taskPools.erase(taskPools.begin() + i);
+				DelLists(pool);
 				delete pool;
 				return;
 			}
@@ -233,10 +493,44 @@ namespace Oak
 
 	void TaskExecutor::GroupTaskPool::Execute(GroupList& groupList, float dt)
 	{
-		for (int j = 0; j < groupList.taskLists.size(); j++)
+		auto& taskLists = groupList.taskLists;
+
+		if (groupList.parallel)
 		{
-			TaskList& taskList = groupList.taskLists[j];
+			parallelTasks.clear();
+
+			for (auto& taskList : taskLists)
+			{
+				SingleTaskPool::BeginList(taskList.list);
 
+				if (taskList.pool->active)
+				{
+					for (auto& task : taskList.list->list)
+					{
+						parallelTasks.push_back(&task);
+					}
+				}
+			}
+
+			GroupJob job;
+			job.tasks = parallelTasks.data();
+			job.dt = dt;
+
+			root.taskExecutor.ExecuteParallel(&job, (int)parallelTasks.size());
+
+			for (auto& taskList : taskLists)
+			{
+				SingleTaskPool::EndList(taskList.list);
+			}
+
+			return;
+		}
+
+		for (int j = 0; j < taskLists.size(); j++)
+		{
+			TaskList& taskList = taskLists[j];
+
+			// level which is marked as parallel only in a pool is executed in parallel within that pool
 			if (taskList.pool->active)
 			{
 				SingleTaskPool::ExecuteList(taskList.list, dt);
@@ -246,48 +540,78 @@ namespace Oak
 
 	void TaskExecutor::GroupTaskPool::Execute(float dt)
 	{
-		FillList();
-
 		int filter_index = (filter.size() > 0) ? 0 : -1;
 
+		executing = true;
+
 		for (int i = 0; i < groupLists.size(); i++)
 		{
 			GroupList& groupList = groupLists[i];
+			int level = groupList.level;
 
 			if (filter_index != -1)
 			{
-				while (filter[filter_index] < groupList.level)
+				while (filter_index < filter.size() && filter[filter_index] < level)
 				{
 					filter_index++;
+				}
 
-					if (filter_index == filter.size())
-					{
-						return;
-					}
+				if (filter_index == filter.size())
+				{
+					break;
 				}
 			}
 
-			if (filter_index != -1 && filter[filter_index] != groupList.level)
+			if (filter_index != -1 && filter[filter_index] != level)
 			{
 				continue;
 			}
 
 			Execute(groupList, dt);
+
+			if (levelFinished.entity)
+			{
+				(levelFinished.entity->*levelFinished.call)(dt);
+			}
+
+			if (pendingLists.size() > 0)
+			{
+				ApplyPendingLists();
+
+				auto next = eastl::upper_bound(groupLists.begin(), groupLists.end(), level, [](int level, const GroupList& groupList) { return level < groupList.level; });
+				i = (int)(next - groupLists.begin()) - 1;
+			}
 		}
+
+		executing = false;
+
+		ApplyPendingLists();
 	}
 
 	void TaskExecutor::GroupTaskPool::ExecutePool(int level, float dt)
 	{
-		for (int i = 0; i < groupLists.size(); i++)
+		GroupList* groupList = FindGroupList(level);
+
+		if (!groupList)
 		{
-			GroupList& groupList = groupLists[i];
+			return;
+		}
 
-			if (groupList.level != level)
-			{
-				continue;
-			}
+		bool wasExecuting = executing;
+		executing = true;
 
-			Execute(groupList, dt);
+		Execute(*groupList, dt);
+
+		if (levelFinished.entity)
+		{
+			(levelFinished.entity->*levelFinished.call)(dt);
+		}
+
+		executing = wasExecuting;
+
+		if (!executing)
+		{
+			ApplyPendingLists();
 		}
 	}
 
@@ -300,4 +624,149 @@ namespace Oak
 	{
 		return new(file, line) GroupTaskPool();
 	}
-}
\ No newline at end of file
+
+	int TaskExecutor::GetWorkersCount()
+	{
+		return workersCount;
+	}
+
+	void TaskExecutor::Init()
+	{
+		workersCount = ThreadExecutor::GetCoresCount() - 1;
+
+		if (workersCount > maxWorkers)
+		{
+			workersCount = maxWorkers;
+		}
+
+		if (workersCount < 0)
+		{
+			workersCount = 0;
+		}
+
+		terminating.store(false, std::memory_order_release);
+
+		for (int i = 0; i < workersCount; i++)
+		{
+			workers[i] = NEW Worker();
+			workers[i]->owner = this;
+			workers[i]->index = i + 1;
+			workers[i]->thread.Execute(workers[i], (ThreadCaller::Delegate)&Worker::Work);
+		}
+	}
+
+	void TaskExecutor::Worker::Work()
+	{
+		while (true)
+		{
+			owner->wakeUp.Wait();
+
+			if (owner->terminating.load(std::memory_order_acquire))
+			{
+				break;
+			}
+
+			owner->Participate(index);
+			owner->busyWorkers.fetch_sub(1, std::memory_order_release);
+		}
+	}
+
+	void TaskExecutor::Participate(int queue)
+	{
+		int start = queue % queuesCount;
+
+		for (int i = 0; i < queuesCount; i++)
+		{
+			WorkQueue& workQueue = queues[(start + i) % queuesCount];
+
+			while (true)
+			{
+				int from = workQueue.next.fetch_add(jobGranularity, std::memory_order_relaxed);
+
+				if (from >= workQueue.end)
+				{
+					break;
+				}
+
+				int to = from + jobGranularity;
+
+				if (to > workQueue.end)
+				{
+					to = workQueue.end;
+				}
+
+				job->Execute(from, to);
+			}
+		}
+	}
+
+	void TaskExecutor::ExecuteParallel(ParallelJob* setJob, int count, int granularity)
+	{
+		if (count <= 0)
+		{
+			return;
+		}
+
+		if (granularity < 1)
+		{
+			granularity = 1;
+		}
+
+		int chunks = (count + granularity - 1) / granularity;
+		int wakeCount = eastl::min(workersCount, chunks - 1);
+
+		if (wakeCount <= 0 || executing.exchange(true, std::memory_order_acquire))
+		{
+			setJob->Execute(0, count);
+			return;
+		}
+
+		job = setJob;
+		jobGranularity = granularity;
+		queuesCount = wakeCount + 1;
+
+		int perQueue = count / queuesCount;
+		int from = 0;
+
+		for (int i = 0; i < queuesCount; i++)
+		{
+			int to = (i == queuesCount - 1) ? count : from + perQueue;
+
+			queues[i].next.store(from, std::memory_order_relaxed);
+			queues[i].end = to;
+
+			from = to;
+		}
+
+		busyWorkers.store(wakeCount, std::memory_order_release);
+		wakeUp.Release(wakeCount);
+
+		Participate(0);
+
+		while (busyWorkers.load(std::memory_order_acquire) > 0)
+		{
+			ThreadExecutor::Sleep(0);
+		}
+
+		job = nullptr;
+		executing.store(false, std::memory_order_release);
+	}
+
+	void TaskExecutor::Release()
+	{
+		terminating.store(true, std::memory_order_release);
+		wakeUp.Release(workersCount);
+
+		for (int i = 0; i < workersCount; i++)
+		{
+			while (workers[i]->thread.IsExecuting())
+			{
+				ThreadExecutor::Sleep(1);
+			}
+
+			delete workers[i];
+		}
+
+		workersCount = 0;
+	}
+}
@@ -2,8 +2,11 @@
 #pragma once
 
 #include "Support/Support.h"
+#include "Support/ThreadExecutor.h"
 #include <eastl/vector.h>
 #include <eastl/map.h>
+#include <eastl/hash_map.h>
+#include <atomic>
 
 namespace Oak
 {
@@ -17,7 +20,10 @@ namespace Oak
 	This class manages execution of tasks. Each task is a callback, i.e. method
 	of class. Task can be ordered by level of execution and can be combined in single
 	pool via class TaskExecutor::SingleTaskPool. Severel task pools can be combined into
-	one group pool via class TaskExecutor::GroupTaskPool.
+	one group pool via class TaskExecutor::GroupTaskPool. Group pool keeps merged schedule of levels
+	of all its pools and patches it only when a pool gets new level or pool is added or deleted. Level of execution can be marked
+	as parallel. In that case tasks of a level are spread among worker threads and next level
+	will be started only after all tasks of a parallel level are finished.
 
 	*/
 
@@ -31,6 +37,23 @@ namespace Oak
 			virtual void Execute(float dt) = 0;
 		};
 
+		/**
+		\brief ParallelJob
+
+		Interface of a job which can be split into ranges of items and executed on worker threads.
+		*/
+		class CLASS_DECLSPEC ParallelJob
+		{
+		public:
+			/**
+			\brief Execute range of items of a job
+
+			\param[in] from Index of first item
+			\param[in] to Index after last item
+			*/
+			virtual void Execute(int from, int to) = 0;
+		};
+
 		class GroupTaskPool;
 
 		class CLASS_DECLSPEC SingleTaskPool : public TaskPool
@@ -48,17 +71,39 @@ namespace Oak
 			struct TaskList
 			{
 				int  level;
+				bool parallel = false;
+				bool executing = false;
+				bool hasDuplicates = false;
+				int  deleted = 0;
 				eastl::vector<Task> list;
+				eastl::vector<Task> pending;
+				eastl::hash_map<Object*, int> indices;
 			};
 
 		private:
 
+			struct ListJob : ParallelJob
+			{
+				Task* tasks = nullptr;
+				float dt = 0.0f;
+
+				void Execute(int from, int to) override;
+			};
+
 			eastl::vector<TaskList*> lists;
 
 			bool active = true;
-			int changeMark = 0;
+
+			GroupTaskPool* group = nullptr;
+			int groupOrder = 0;
 
 			TaskList* FindTaskList(int level);
+			TaskList* GetTaskList(int level);
+			static void PushTask(TaskList* list, const Task& task);
+			static void CompactList(TaskList* list);
+			static void BeginList(TaskList* list);
+			static void EndList(TaskList* list);
+			static void ExecuteTask(Task& task, float dt);
 			static void ExecuteList(TaskList* list, float dt);
 
 		public:
@@ -72,6 +117,16 @@ namespace Oak
 			*/
 			void SetActive(bool set);
 
+			/**
+			\brief Mark level of execution as parallel. Tasks of such level are executed on worker threads,
+			so they should not touch shared state like render device. If pool is attached to a group,
+			tasks are executed in parallel only within this pool.
+
+			\param[in] level Level of execution
+			\param[in] set Define parallel state
+			*/
+			void SetLevelParallel(int level, bool set);
+
 			/**
 			\brief Execute all tasks in a pool
 
@@ -80,7 +135,8 @@ namespace Oak
 			virtual void Execute(float dt);
 
 			/**
-			\brief Adding task in a pool
+			\brief Adding task in a pool. If level is executing right now task will be added after
+			execution of a level is finished.
 
 			\param[in] level Priority level of execution. Lower numbers means earlst execution.
 			\param[in] entity Pointer to object which method should be executed
@@ -91,7 +147,8 @@ namespace Oak
 			void AddTask(int level, Object* entity, Object::Delegate call, float freq = -1.0f);
 
 			/**
-			\brief Delete task in a pool
+			\brief Delete task in a pool. Deleted task is marked as removed and list is compacted
+			before next execution of a level, so deletion is safe from inside of a running task.
 
 			\param[in] level Priority level of execution. Lower numbers means earlst execution.
 			\param[in] entity Pointer to object which method should be executed
@@ -123,15 +180,33 @@ namespace Oak
 			struct GroupList
 			{
 				int level;
+				bool parallel = false;
 				eastl::vector<TaskList> taskLists;
 			};
 
+			struct GroupJob : ParallelJob
+			{
+				SingleTaskPool::Task** tasks = nullptr;
+				float dt = 0.0f;
+
+				void Execute(int from, int to) override;
+			};
+
 			eastl::vector<GroupList> groupLists;
 			eastl::vector<SingleTaskPool*> taskPools;
-			eastl::vector<int> changeMarks;
 			eastl::vector<int> filter;
-
-			void FillList();
+			eastl::vector<int> parallelLevels;
+			eastl::vector<SingleTaskPool::Task*> parallelTasks;
+			eastl::vector<TaskList> pendingLists;
+			int poolsCounter = 0;
+			DelegateObject levelFinished = { nullptr, nullptr };
+			bool executing = false;
+
+			GroupList* FindGroupList(int level);
+			void AddList(SingleTaskPool* pool, SingleTaskPool::TaskList* list);
+			void InsertList(SingleTaskPool* pool, SingleTaskPool::TaskList* list);
+			void ApplyPendingLists();
+			void DelLists(SingleTaskPool* pool);
 			void Execute(GroupList& groupList, float dt);
 
 		public:
@@ -143,6 +218,23 @@ namespace Oak
 			*/
 			void AddFilter(int level);
 
+			/**
+			\brief Set callback which is called on a calling thread after all tasks of a level were executed
+
+			\param[in] entity Pointer to object which method should be executed
+			\param[in] call Pointer to a method of a owner class
+			*/
+			void SetLevelFinishedCallback(Object* entity, Object::Delegate call);
+
+			/**
+			\brief Mark level of execution as parallel. Tasks of all pools with such level are executed
+			on worker threads, so they should not touch shared state like render device.
+
+			\param[in] level Level of execution
+			\param[in] set Define parallel state
+			*/
+			void SetLevelParallel(int level, bool set);
+
 			/**
 			\brief Create new task pool in a group
 
@@ -150,6 +242,16 @@ namespace Oak
 			*/
 			SingleTaskPool* AddTaskPool(const char* file, int line);
 
+			/**
+			\brief Add existing pool to a group. Pool could be filled before it was attached,
+			so it is allowed to prepare a pool on other thread.
+
+			\param[in] pool Pointer to TaskExecutor::SingleTaskPool
+
+			\return Pointer to TaskExecutor::SingleTaskPool
+			*/
+			SingleTaskPool* AttachTaskPool(SingleTaskPool* pool);
+
 			/**
 			\brief Delete pool for a group.
 
@@ -192,5 +294,63 @@ namespace Oak
 		\return Pointer to TaskExecutor::GroupTaskPool
 		*/
 		GroupTaskPool* CreateGroupTaskPool(const char* file, int line);
+
+		/**
+		\brief Get count of worker threads
+
+		\return Count of worker threads. Zero means that all jobs are executed on a calling thread
+		*/
+		int GetWorkersCount();
+
+		/**
+		\brief Execute a job on worker threads. Each worker takes ranges of items from own queue and steals
+		ranges from queues of other workers when own queue is empty. Method returns after all items are executed.
+
+		\param[in] job Pointer to a job
+		\param[in] count Count of items in a job
+		\param[in] granularity Count of items which are taken from a queue at once
+		*/
+		void ExecuteParallel(ParallelJob* job, int count, int granularity = 16);
+
+	#ifndef DOXYGEN_SKIP
+		void Init();
+		void Release();
+
+	private:
+
+		class Worker : public ThreadCaller
+		{
+		public:
+			TaskExecutor* owner = nullptr;
+			int index = 0;
+			ThreadExecutor thread;
+
+			void Work();
+		};
+
+		struct alignas(64) WorkQueue
+		{
+			std::atomic<int> next{ 0 };
+			int end = 0;
+		};
+
+		constexpr static int maxWorkers = 31;
+
+		Worker* workers[maxWorkers];
+		int workersCount = 0;
+
+		WorkQueue queues[maxWorkers + 1];
+		int queuesCount = 0;
+
+		ParallelJob* job = nullptr;
+		int jobGranularity = 1;
+
+		ThreadSemaphore wakeUp;
+		std::atomic<int> busyWorkers{ 0 };
+		std::atomic<bool> executing{ false };
+		std::atomic<bool> terminating{ false };
+
+		void Participate(int queue);
+	#endif
 	};
 }
\ No newline at end of file
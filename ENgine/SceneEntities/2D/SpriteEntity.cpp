@@ -4,7 +4,7 @@
 
 namespace Oak
 {
-	CLASSREG(SceneEntity, SpriteEntity, "Sprite")
+	CLASSREG_POOLED(SceneEntity, SpriteEntity, "Sprite")
 
 	META_DATA_DESC(SpriteEntity)
 		BASE_SCENE_ENTITY_PROP(SpriteEntity)
@@ -35,6 +35,17 @@ namespace Oak
 	{
 		transform.BuildMatrices();
 
+		// bounds of a quad which is drawn by AssetTextureRef::Draw
+		Math::Vector3 bbMin(-transform.offset.x * transform.size.x, (transform.offset.y - 1.0f) * transform.size.y, 0.0f);
+		Math::Vector3 bbMax((1.0f - transform.offset.x) * transform.size.x, transform.offset.y * transform.size.y, 0.0f);
+
+		Math::TransformBBox(transform.global, bbMin, bbMax);
+
+		if (!UpdateBounds(bbMin * Sprite::pixelsPerUnitInvert, bbMax * Sprite::pixelsPerUnitInvert))
+		{
+			return;
+		}
+
 		texture.Draw(&transform, COLOR_WHITE, dt);
 	}
 }
\ No newline at end of file
@@ -4,7 +4,7 @@
 
 namespace Oak
 {
-	CLASSREG(SceneEntity, ModelEntity, "Mesh3D")
+	CLASSREG_POOLED(SceneEntity, ModelEntity, "Mesh3D")
 
 	META_DATA_DESC(ModelEntity)
 		BASE_SCENE_ENTITY_PROP(ModelEntity)
@@ -25,6 +25,11 @@ namespace Oak
 	{
 		RELEASE(mesh)
 		mesh = root.meshes.LoadMesh(meshPath.c_str(), Tasks(true));
+
+		if (mesh)
+		{
+			mesh->cullingEntry = &cullingEntry;
+		}
 	}
 
 	void ModelEntity::Update(float dt)
@@ -33,6 +38,12 @@ namespace Oak
 		{
 			transform.BuildMatrices();
 			mesh->transform = transform.global;
+
+			Math::Vector3 bbMin = mesh->GetBBMin();
+			Math::Vector3 bbMax = mesh->GetBBMax();
+			Math::TransformBBox(transform.global, bbMin, bbMax);
+
+			UpdateBounds(bbMin, bbMax);
 		}
 	}
 }
\ No newline at end of file
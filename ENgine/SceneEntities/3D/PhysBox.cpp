@@ -5,7 +5,7 @@
 namespace Oak
 {
 
-	CLASSREG(SceneEntity, PhysBox, "PhysBox")
+	CLASSREG_POOLED(SceneEntity, PhysBox, "PhysBox")
 
 	META_DATA_DESC(PhysBox)
 		BASE_SCENE_ENTITY_PROP(PhysBox)
@@ -1,16 +1,19 @@
-
+﻿
 #include "Terrain.h"
 #include "Root/Root.h"
 #include "Root/Meshes/MeshPrograms.h"
+#include <float.h>
+#include <xmmintrin.h>
 
 namespace Oak
 {
-	CLASSREG(SceneEntity, Terrain, "Terrain")
+	CLASSREG_POOLED(SceneEntity, Terrain, "Terrain")
 
 	META_DATA_DESC(Terrain)
 		BASE_SCENE_ENTITY_PROP(Terrain)
 		FLOAT_PROP(Terrain, scaleh, 0.5f, "Geometry", "ScaleH", "Horizontal scale")
 		FLOAT_PROP(Terrain, scalev, 0.1f, "Geometry", "ScaleV", "Vertical scale")
+		FLOAT_PROP(Terrain, lodDistance, 40.0f, "Geometry", "LOD distance", "Distance up to which chunks are drawn with full details")
 		FILENAME_PROP(Terrain, tex_name, "", "Geometry", "Texture")
 		FILENAME_PROP(Terrain, hgt_name, "", "Geometry", "Heightmap")
 		COLOR_PROP(Terrain, color, COLOR_WHITE, "Geometry", "Color")
@@ -28,9 +31,6 @@ namespace Oak
 
 	void Terrain::Init()
 	{
-		VertexDecl::ElemDesc desc[] = { { ElementType::Float3, ElementSemantic::Position, 0 },{ ElementType::Float2, ElementSemantic::Texcoord, 0 },{ ElementType::Float3, ElementSemantic::Texcoord, 1 } };
-		vdecl = root.render.GetDevice()->CreateVertexDecl(3, desc, _FL_);
-
 		Tasks(true)->AddTask(10, this, (Object::Delegate)&Terrain::Render);
 
 		GetScene()->AddToGroup(this, "Terrain");
@@ -38,137 +38,320 @@ namespace Oak
 
 	void Terrain::ApplyProperties()
 	{
-		int stride = sizeof(VertexTri);
+		uint8_t* prevHMap = hmap;
+		int prevWidth = hwidth;
+		int prevHeight = hheight;
+
+		hmap = nullptr;
 
 		LoadHMap(hgt_name.c_str());
 
-		sz = (hwidth) * (hheight) * 2;
+		// device resources are created here as Init can be called on a scene streaming thread
+		if (!vdecl)
+		{
+			VertexDecl::ElemDesc desc[] = { { ElementType::Float3, ElementSemantic::Position, 0 },{ ElementType::Float2, ElementSemantic::Texcoord, 0 },{ ElementType::Float3, ElementSemantic::Texcoord, 1 } };
+			vdecl = root.render.GetDevice()->CreateVertexDecl(3, desc, _FL_);
+		}
 
-		buffer = root.render.GetDevice()->CreateBuffer(sz * 3, stride, _FL_);
+		if (!indices)
+		{
+			BuildIndices();
+		}
 
-		VertexTri* v_tri = (VertexTri*)buffer->Lock();
+		bool rebuildAll = !prevHMap || !hmap || prevWidth != hwidth || prevHeight != hheight || builtScaleH != scaleh || builtScaleV != scalev;
 
-		float start_x = -hwidth * 0.5f * scaleh;
-		float start_z = -hheight * 0.5f * scaleh;
+		if (rebuildAll)
+		{
+			chunksX = (hwidth + chunkCells - 2) / chunkCells;
+			chunksZ = (hheight + chunkCells - 2) / chunkCells;
 
-		float du = 1.0f / (hwidth - 1.0f);
-		float dv = 1.0f / (hheight - 1.0f);
+			chunks.clear();
+			chunks.resize(chunksX * chunksZ);
 
-		bool shift = false;
+			builtScaleH = scaleh;
+			builtScaleV = scalev;
+		}
 
-		for (int j = 0; j < hheight - 1; j++)
+		BuildJob job;
+		job.terrain = this;
+
+		for (int cz = 0; cz < chunksZ; cz++)
 		{
-			for (int i = 0; i < hwidth - 1; i++)
+			for (int cx = 0; cx < chunksX; cx++)
 			{
-				if (shift)
-				{
-					if (i % 2 == 0)
-					{
-						v_tri[1].position = GetVecHeight(i,j);
-						v_tri[1].texCoord = Math::Vector2(0.0f, 0.0f);
-						v_tri[0].position = GetVecHeight(i+1, j);
-						v_tri[0].texCoord = Math::Vector2(1.0f, 0.0f);
-						v_tri[2].position = GetVecHeight(i+1, j+1);
-						v_tri[2].texCoord = Math::Vector2(1.0f, 1.0f);
-
-						v_tri[4].position = GetVecHeight(i, j);
-						v_tri[4].texCoord = Math::Vector2(0.0f, 0.0f);
-						v_tri[3].position = GetVecHeight(i + 1, j + 1);
-						v_tri[3].texCoord = Math::Vector2(1.0f, 1.0f);
-						v_tri[5].position = GetVecHeight(i, j + 1);
-						v_tri[5].texCoord = Math::Vector2(0.0f, 1.0f);
-					}
-					else
-					{
-						v_tri[1].position = GetVecHeight(i+1,j);
-						v_tri[1].texCoord = Math::Vector2(1.0f, 0.0f);
-						v_tri[0].position = GetVecHeight(i+1,j+1);
-						v_tri[0].texCoord = Math::Vector2(1.0f, 1.0f);
-						v_tri[2].position = GetVecHeight(i, j+1);
-						v_tri[2].texCoord = Math::Vector2(0.0f, 1.0f);
-
-						v_tri[4].position = GetVecHeight(i, j);
-						v_tri[4].texCoord = Math::Vector2(0.0f, 0.0f);
-						v_tri[3].position = GetVecHeight(i+1, j);
-						v_tri[3].texCoord = Math::Vector2(1.0f, 0.0f);
-						v_tri[5].position = GetVecHeight(i, j + 1);
-						v_tri[5].texCoord = Math::Vector2(0.0f, 1.0f);
-					}
-				}
-				else
+				if (rebuildAll || IsChunkChanged(cx, cz, prevHMap))
 				{
-					if (i % 2 == 0)
-					{
-						v_tri[1].position = GetVecHeight(i, j);
-						v_tri[1].texCoord = Math::Vector2(0.0f, 0.0f);
-						v_tri[0].position = GetVecHeight(i + 1, j);
-						v_tri[0].texCoord = Math::Vector2(1.0f, 0.0f);
-						v_tri[2].position = GetVecHeight(i, j + 1);
-						v_tri[2].texCoord = Math::Vector2(0.0f, 1.0f);
-
-						v_tri[4].position = GetVecHeight(i + 1, j);
-						v_tri[4].texCoord = Math::Vector2(1.0f, 0.0f);
-						v_tri[3].position = GetVecHeight(i + 1, j + 1);
-						v_tri[3].texCoord = Math::Vector2(1.0f, 1.0f);
-						v_tri[5].position = GetVecHeight(i, j + 1);
-						v_tri[5].texCoord = Math::Vector2(0.0f, 1.0f);
-					}
-					else
-					{
-						v_tri[1].position = GetVecHeight(i, j);
-						v_tri[1].texCoord = Math::Vector2(0.0f, 0.0f);
-						v_tri[0].position = GetVecHeight(i + 1, j + 1);
-						v_tri[0].texCoord = Math::Vector2(1.0f, 1.0f);
-						v_tri[2].position = GetVecHeight(i, j + 1);
-						v_tri[2].texCoord = Math::Vector2(0.0f, 1.0f);
-
-						v_tri[4].position = GetVecHeight(i, j);
-						v_tri[4].texCoord = Math::Vector2(0.0f, 0.0f);
-						v_tri[3].position = GetVecHeight(i + 1, j);
-						v_tri[3].texCoord = Math::Vector2(1.0f, 0.0f);
-						v_tri[5].position = GetVecHeight(i + 1, j + 1);
-						v_tri[5].texCoord = Math::Vector2(1.0f, 1.0f);
-					}
+					job.chunks.push_back(cz * chunksX + cx);
 				}
+			}
+		}
 
-				float cur_du = du * i;
-				float cur_dv = dv * (hheight - 1 - j);
+		FREE_PTR(prevHMap)
 
-				for (int k = 0; k < 6; k++)
-				{
-					v_tri[k].position.x = start_x + v_tri[k].position.x * scaleh;
-					v_tri[k].position.z = start_z - v_tri[k].position.z * scaleh;
-					v_tri[k].texCoord = Math::Vector2(cur_du + v_tri[k].texCoord.x * du, cur_dv - v_tri[k].texCoord.y * dv);
-				}
+		BuildChunks(job);
+
+		Math::Vector3 bbMin(FLT_MAX);
+		Math::Vector3 bbMax(-FLT_MAX);
+
+		for (auto& chunk : chunks)
+		{
+			bbMin.Min(chunk.bbMin);
+			bbMax.Max(chunk.bbMax);
+		}
 
-				for (int k = 0; k < 2; k++)
+		texture = root.render.LoadTexture(tex_name.c_str(), _FL_);
+
+		UpdateBounds(bbMin, bbMax);
+	}
+
+	void Terrain::BuildIndices()
+	{
+		eastl::vector<uint16_t> data;
+
+		for (int lod = 0; lod < lodsCount; lod++)
+		{
+			int step = 1 << lod;
+
+			// the coarsest level has no coarser neighbours
+			int variants = (lod < lodsCount - 1) ? StitchVariants : 1;
+
+			for (int mask = 0; mask < variants; mask++)
+			{
+				LodRange& range = lodRanges[lod][mask];
+				range.startIndex = (int)data.size();
+
+				for (int z = 0; z < chunkCells; z += step)
 				{
-					Math::Vector3 v1 = v_tri[k * 3 + 1].position - v_tri[k * 3 + 0].position;
-					Math::Vector3 v2 = v_tri[k * 3 + 2].position - v_tri[k * 3 + 0].position;
-				
-					v1.Normalize();
-					v2.Normalize();
-
-					Math::Vector3 normal;
-				
-					normal = v1.Cross(v2);
-					normal.Normalize();
-
-					for (int l = 0; l < 3; l++)
+					for (int x = 0; x < chunkCells; x += step)
 					{
-						v_tri[k * 3 + l].normal = normal;
+						uint16_t a = (uint16_t)GetStitchedIndex(x, z, step, mask);
+						uint16_t b = (uint16_t)GetStitchedIndex(x + step, z, step, mask);
+						uint16_t c = (uint16_t)GetStitchedIndex(x, z + step, step, mask);
+						uint16_t d = (uint16_t)GetStitchedIndex(x + step, z + step, step, mask);
+
+						data.push_back(b);
+						data.push_back(a);
+						data.push_back(c);
+
+						data.push_back(d);
+						data.push_back(b);
+						data.push_back(c);
 					}
 				}
 
-				v_tri += 6;
+				range.primCount = ((int)data.size() - range.startIndex) / 3;
 			}
 
-			shift = !shift;
+			for (int mask = variants; mask < StitchVariants; mask++)
+			{
+				lodRanges[lod][mask] = lodRanges[lod][0];
+			}
 		}
 
-		buffer->Unlock();
+		indices = root.render.GetDevice()->CreateBuffer((int)data.size(), sizeof(uint16_t), _FL_);
 
-		texture = root.render.LoadTexture(tex_name.c_str(), _FL_);
+		memcpy(indices->Lock(), data.data(), data.size() * sizeof(uint16_t));
+
+		indices->Unlock();
+	}
+
+	int Terrain::GetStitchedIndex(int x, int z, int step, int mask)
+	{
+		// odd vertices of a side next to coarser chunk are snapped to previous vertex of coarser grid,
+		// so triangles near a side become degenerated and side matches a side of coarser grid
+		int coarseMask = ~(step * 2 - 1);
+
+		if (((mask & StitchLeft) && x == 0) || ((mask & StitchRight) && x == chunkCells))
+		{
+			z &= coarseMask;
+		}
+
+		if (((mask & StitchTop) && z == 0) || ((mask & StitchBottom) && z == chunkCells))
+		{
+			x &= coarseMask;
+		}
+
+		return z * (chunkCells + 1) + x;
+	}
+
+	bool Terrain::IsChunkChanged(int cx, int cz, const uint8_t* prevHMap)
+	{
+		// normals depend on neighbour samples, so samples around a chunk are compared too
+		int fromX = eastl::max(cx * chunkCells - 1, 0);
+		int toX = eastl::min((cx + 1) * chunkCells + 1, hwidth - 1);
+		int fromZ = eastl::max(cz * chunkCells - 1, 0);
+		int toZ = eastl::min((cz + 1) * chunkCells + 1, hheight - 1);
+
+		for (int j = fromZ; j <= toZ; j++)
+		{
+			if (memcmp(&hmap[j * hwidth + fromX], &prevHMap[j * hwidth + fromX], toX - fromX + 1) != 0)
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	void Terrain::BuildJob::Execute(int from, int to)
+	{
+		for (int item = from; item < to; item++)
+		{
+			int index = item / (chunkCells + 1);
+			int z = item % (chunkCells + 1);
+
+			int chunk = chunks[index];
+
+			terrain->BuildRow(chunk % terrain->chunksX, chunk / terrain->chunksX, z, vertices[index] + z * (chunkCells + 1), rowsMin[item], rowsMax[item]);
+		}
+	}
+
+	void Terrain::BuildChunks(BuildJob& job)
+	{
+		int rowsCount = (int)job.chunks.size() * (chunkCells + 1);
+
+		if (rowsCount == 0)
+		{
+			return;
+		}
+
+		// buffers are mapped on a calling thread, workers only fill mapped memory
+		for (int index : job.chunks)
+		{
+			Chunk& chunk = chunks[index];
+
+			if (!chunk.vertices)
+			{
+				chunk.vertices = root.render.GetDevice()->CreateBuffer((chunkCells + 1) * (chunkCells + 1), sizeof(VertexTri), _FL_);
+			}
+
+			job.vertices.push_back((VertexTri*)chunk.vertices->Lock());
+		}
+
+		job.rowsMin.resize(rowsCount);
+		job.rowsMax.resize(rowsCount);
+
+		root.taskExecutor.ExecuteParallel(&job, rowsCount, 8);
+
+		for (int i = 0; i < (int)job.chunks.size(); i++)
+		{
+			Chunk& chunk = chunks[job.chunks[i]];
+
+			chunk.vertices->Unlock();
+
+			chunk.bbMin = Math::Vector3(FLT_MAX);
+			chunk.bbMax = Math::Vector3(-FLT_MAX);
+
+			for (int z = 0; z <= chunkCells; z++)
+			{
+				chunk.bbMin.Min(job.rowsMin[i * (chunkCells + 1) + z]);
+				chunk.bbMax.Max(job.rowsMax[i * (chunkCells + 1) + z]);
+			}
+		}
+	}
+
+	void Terrain::BuildRow(int cx, int cz, int z, VertexTri* v_tri, Math::Vector3& bbMin, Math::Vector3& bbMax)
+	{
+		constexpr int count = chunkCells + 1;
+		constexpr int padded = (count + 3) & ~3;
+
+		alignas(16) float coordX[padded];
+		alignas(16) float invDistX[padded];
+		alignas(16) float center[padded];
+		alignas(16) float left[padded];
+		alignas(16) float right[padded];
+		alignas(16) float top[padded];
+		alignas(16) float bottom[padded];
+
+		// last chunk can be partial, its outer vertices are collapsed onto a border of a height map
+		int j = eastl::min(cz * chunkCells + z, hheight - 1);
+		int prevJ = eastl::max(j - 1, 0);
+		int nextJ = eastl::min(j + 1, hheight - 1);
+
+		// padding lanes repeat last vertex of a row
+		for (int x = 0; x < padded; x++)
+		{
+			int i = eastl::min(cx * chunkCells + eastl::min(x, chunkCells), hwidth - 1);
+			int prevI = eastl::max(i - 1, 0);
+			int nextI = eastl::min(i + 1, hwidth - 1);
+
+			coordX[x] = (float)i;
+			invDistX[x] = 1.0f / ((nextI - prevI) * scaleh);
+			center[x] = GetHeight(i, j);
+			left[x] = GetHeight(prevI, j);
+			right[x] = GetHeight(nextI, j);
+			top[x] = GetHeight(i, prevJ);
+			bottom[x] = GetHeight(i, nextJ);
+		}
+
+		float posZ = -hheight * 0.5f * scaleh + j * scaleh;
+		float texV = (hheight - 1 - j) / (hheight - 1.0f);
+
+		__m128 one = _mm_set1_ps(1.0f);
+		__m128 zero = _mm_setzero_ps();
+		__m128 startX = _mm_set1_ps(-hwidth * 0.5f * scaleh);
+		__m128 scaleX = _mm_set1_ps(scaleh);
+		__m128 du = _mm_set1_ps(1.0f / (hwidth - 1.0f));
+		__m128 invDistZ = _mm_set1_ps(1.0f / ((nextJ - prevJ) * scaleh));
+
+		__m128 minX = _mm_set1_ps(FLT_MAX);
+		__m128 minY = minX;
+		__m128 maxX = _mm_set1_ps(-FLT_MAX);
+		__m128 maxY = maxX;
+
+		alignas(16) float posX[4];
+		alignas(16) float posY[4];
+		alignas(16) float texU[4];
+		alignas(16) float normX[4];
+		alignas(16) float normY[4];
+		alignas(16) float normZ[4];
+
+		for (int x = 0; x < count; x += 4)
+		{
+			__m128 coord = _mm_load_ps(&coordX[x]);
+			__m128 height = _mm_load_ps(&center[x]);
+
+			__m128 slopeX = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(&right[x]), _mm_load_ps(&left[x])), _mm_load_ps(&invDistX[x]));
+			__m128 slopeZ = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(&bottom[x]), _mm_load_ps(&top[x])), invDistZ);
+
+			// normal is (-slopeX, 1, -slopeZ) divided by its length
+			__m128 lengthSq = _mm_add_ps(one, _mm_add_ps(_mm_mul_ps(slopeX, slopeX), _mm_mul_ps(slopeZ, slopeZ)));
+			__m128 invLength = _mm_div_ps(one, _mm_sqrt_ps(lengthSq));
+
+			__m128 position = _mm_add_ps(startX, _mm_mul_ps(coord, scaleX));
+
+			_mm_store_ps(posX, position);
+			_mm_store_ps(posY, height);
+			_mm_store_ps(texU, _mm_mul_ps(coord, du));
+			_mm_store_ps(normX, _mm_mul_ps(_mm_sub_ps(zero, slopeX), invLength));
+			_mm_store_ps(normY, invLength);
+			_mm_store_ps(normZ, _mm_mul_ps(_mm_sub_ps(zero, slopeZ), invLength));
+
+			minX = _mm_min_ps(minX, position);
+			maxX = _mm_max_ps(maxX, position);
+			minY = _mm_min_ps(minY, height);
+			maxY = _mm_max_ps(maxY, height);
+
+			int lanes = eastl::min(4, count - x);
+
+			for (int k = 0; k < lanes; k++)
+			{
+				v_tri->position = Math::Vector3(posX[k], posY[k], posZ);
+				v_tri->texCoord = Math::Vector2(texU[k], texV);
+				v_tri->normal = Math::Vector3(normX[k], normY[k], normZ[k]);
+
+				v_tri++;
+			}
+		}
+
+		alignas(16) float bounds[4][4];
+		_mm_store_ps(bounds[0], minX);
+		_mm_store_ps(bounds[1], maxX);
+		_mm_store_ps(bounds[2], minY);
+		_mm_store_ps(bounds[3], maxY);
+
+		bbMin = Math::Vector3(fminf(fminf(bounds[0][0], bounds[0][1]), fminf(bounds[0][2], bounds[0][3])), fminf(fminf(bounds[2][0], bounds[2][1]), fminf(bounds[2][2], bounds[2][3])), posZ);
+		bbMax = Math::Vector3(fmaxf(fmaxf(bounds[1][0], bounds[1][1]), fmaxf(bounds[1][2], bounds[1][3])), fmaxf(fmaxf(bounds[3][0], bounds[3][1]), fmaxf(bounds[3][2], bounds[3][3])), posZ);
 	}
 
 	float Terrain::GetHeight(int i, int j)
@@ -244,8 +427,91 @@ namespace Oak
 	#endif
 	}
 
+	void Terrain::SelectLods(const Math::Vector3& camPos)
+	{
+		for (auto& chunk : chunks)
+		{
+			Math::Vector3 closest = camPos;
+			closest.Max(chunk.bbMin);
+			closest.Min(chunk.bbMax);
+
+			float dist = (closest - camPos).Length();
+			float lodRange = lodDistance;
+
+			chunk.lod = 0;
+
+			while (chunk.lod < lodsCount - 1 && dist > lodRange)
+			{
+				chunk.lod++;
+				lodRange *= 2.0f;
+			}
+		}
+
+		// stitching supports only neighbours which are coarser by one level
+		bool changed = true;
+
+		while (changed)
+		{
+			changed = false;
+
+			for (int cz = 0; cz < chunksZ; cz++)
+			{
+				for (int cx = 0; cx < chunksX; cx++)
+				{
+					int& lod = chunks[cz * chunksX + cx].lod;
+
+					int minLod = lod;
+
+					if (cx > 0) minLod = eastl::min(minLod, chunks[cz * chunksX + cx - 1].lod);
+					if (cx < chunksX - 1) minLod = eastl::min(minLod, chunks[cz * chunksX + cx + 1].lod);
+					if (cz > 0) minLod = eastl::min(minLod, chunks[(cz - 1) * chunksX + cx].lod);
+					if (cz < chunksZ - 1) minLod = eastl::min(minLod, chunks[(cz + 1) * chunksX + cx].lod);
+
+					if (lod > minLod + 1)
+					{
+						lod = minLod + 1;
+						changed = true;
+					}
+				}
+			}
+		}
+	}
+
+	int Terrain::GetStitchMask(int cx, int cz)
+	{
+		int lod = chunks[cz * chunksX + cx].lod;
+		int mask = 0;
+
+		if (cx > 0 && chunks[cz * chunksX + cx - 1].lod > lod)
+		{
+			mask |= StitchLeft;
+		}
+
+		if (cx < chunksX - 1 && chunks[cz * chunksX + cx + 1].lod > lod)
+		{
+			mask |= StitchRight;
+		}
+
+		if (cz > 0 && chunks[(cz - 1) * chunksX + cx].lod > lod)
+		{
+			mask |= StitchTop;
+		}
+
+		if (cz < chunksZ - 1 && chunks[(cz + 1) * chunksX + cx].lod > lod)
+		{
+			mask |= StitchBottom;
+		}
+
+		return mask;
+	}
+
 	void Terrain::Render(float dt)
 	{
+		if (IsCulled())
+		{
+			return;
+		}
+
 		Render(MeshPrograms::GetTranglPrg());
 	}
 
@@ -254,27 +520,62 @@ namespace Oak
 		Render(MeshPrograms::GetShdTranglPrg());
 	}
 
-	void Terrain::Render(Program* prg)
+	void Terrain::Render(Program* program)
 	{
-		root.render.GetDevice()->SetVertexDecl(vdecl);
-		root.render.GetDevice()->SetVertexBuffer(0, buffer);
+		// only programs from MeshPrograms are passed here
+		auto* prg = (MeshPrograms::MeshProgram*)program;
 
-		root.render.GetDevice()->SetProgram(prg);
+		CommandBuffer* commands = root.render.GetCommandBuffer();
 
 		root.render.SetTransform(TransformStage::World, Math::Matrix());
 
+		Math::Matrix view;
+		root.render.GetTransform(TransformStage::View, view);
+
+		Math::Matrix proj;
+		root.render.GetTransform(TransformStage::Projection, proj);
+
+		Math::Frustum frustum;
+		frustum.Build(view * proj);
+
+		Math::Matrix camera = view;
+		camera.Inverse();
+
+		SelectLods(camera.Pos());
+
+		commands->SetProgram(prg);
+		commands->SetVertexDecl(vdecl);
+		commands->SetIndexBuffer(indices);
+
 		Math::Matrix view_proj;
 		root.render.GetTransform(TransformStage::WrldViewProj, view_proj);
 
 		Math::Matrix mat;
 		Math::Matrix world;
 
-		prg->SetMatrix(ShaderType::Vertex, "trans", &world, 1);
-		prg->SetMatrix(ShaderType::Vertex, "view_proj", &view_proj, 1);
-		prg->SetVector(ShaderType::Pixel, "color", (Math::Vector4*)&color, 1);
-		prg->SetTexture(ShaderType::Pixel, "diffuseMap", texture);
+		commands->SetMatrix(prg->trans, &world, 1);
+		commands->SetMatrix(prg->viewProj, &view_proj, 1);
+		commands->SetVector(prg->color, (Math::Vector4*)&color, 1);
+		commands->SetTexture(prg->diffuseMap, texture);
+
+		for (int cz = 0; cz < chunksZ; cz++)
+		{
+			for (int cx = 0; cx < chunksX; cx++)
+			{
+				Chunk& chunk = chunks[cz * chunksX + cx];
+
+				if (!frustum.IsBoxVisible(chunk.bbMin, chunk.bbMax))
+				{
+					continue;
+				}
+
+				LodRange& range = lodRanges[chunk.lod][GetStitchMask(cx, cz)];
 
-		root.render.GetDevice()->Draw(PrimitiveTopology::TrianglesList, 0, sz);
+				commands->SetVertexBuffer(chunk.vertices);
+				commands->SetDepth(view.MulVertex((chunk.bbMin + chunk.bbMax) * 0.5f).z);
+				commands->DrawIndexed(PrimitiveTopology::TrianglesList, 0, range.startIndex, range.primCount);
+			}
+		}
 	}
 
 	bool Terrain::Play()
@@ -4,6 +4,7 @@
 #include "Root/Render/Render.h"
 #include "Root/Scenes/SceneEntity.h"
 #include "Root/Physics/PhysScene.h"
+#include "Root/TaskExecutor/TaskExecutor.h"
 
 namespace Oak
 {
@@ -12,7 +13,8 @@ namespace Oak
 	\page scene_object_3D_Terrain Terrain
 
 	Terrain costracted from height map and textured by one big texture. Size is taken from
-	dimention of a texture. Vertical and horizontal scales can be adjusted.
+	dimention of a texture. Vertical and horizontal scales can be adjusted. Terrain is split into
+	chunks which are culled separately and drawn with level of detail selected by distance to a camera.
 
 	This class ::Terrain is a representation on C++ side.
 
@@ -26,6 +28,7 @@ namespace Oak
 	Texture           | Filename of a texture
 	Heightmap         | Filename of a high map
 	Color             | Overlay color of a terrain
+	LOD distance      | Distance up to which chunks are drawn with full details
 
 	*/
 
@@ -40,6 +43,16 @@ namespace Oak
 	Terrain costracted from height map and textured by one big texture. Size is taken from
 	dimention of a texture. Vertical and horizontal scales can be adjusted.
 
+	Terrain is split into chunks of chunkCells x chunkCells cells. Every chunk has own vertex buffer
+	with one vertex per sample of a height map, and all chunks share one index buffer. Index buffer
+	contains grids for every level of detail, each next level uses every second vertex. Level of a chunk
+	is selected by distance to a camera and differs from levels of neighbours not more than by one.
+	Vertices on a side which borders with coarser chunk are snapped to vertices of coarser grid, so
+	there are no cracks between chunks. Each level has variants of a grid for every combination of such sides.
+
+	Vertices are built row by row on worker threads, four vertices of a row are processed at once with SSE.
+	When properties are applied again only chunks which samples of a height map were changed are rebuilt.
+
 	*/
 
 	class Terrain : public SceneEntity
@@ -76,13 +89,38 @@ namespace Oak
 
 		Color color;
 
+		/**
+		\brief Distance up to which chunks are drawn with full details. Each next level of detail covers twice longer distance.
+		*/
+
+		float lodDistance;
+
 	#ifndef DOXYGEN_SKIP
-		TextureRef    texture;
-		VertexDeclRef vdecl;
-		DataBufferRef buffer;
-		int      hwidth;
-		int      hheight;
-		uint8_t* hmap = nullptr;
+		constexpr static int chunkCells = 64;
+		constexpr static int lodsCount = 7;
+
+		enum StitchSide
+		{
+			StitchLeft = 1,
+			StitchRight = 2,
+			StitchTop = 4,
+			StitchBottom = 8,
+			StitchVariants = 16
+		};
+
+		struct Chunk
+		{
+			DataBufferRef vertices;
+			Math::Vector3 bbMin;
+			Math::Vector3 bbMax;
+			int lod = 0;
+		};
+
+		struct LodRange
+		{
+			int startIndex = 0;
+			int primCount = 0;
+		};
 
 		struct VertexTri
 		{
@@ -91,7 +129,29 @@ namespace Oak
 			Math::Vector3 normal;
 		};
 
-		int sz;
+		struct BuildJob : TaskExecutor::ParallelJob
+		{
+			Terrain* terrain = nullptr;
+			eastl::vector<int> chunks;
+			eastl::vector<VertexTri*> vertices;
+			eastl::vector<Math::Vector3> rowsMin;
+			eastl::vector<Math::Vector3> rowsMax;
+
+			void Execute(int from, int to) override;
+		};
+
+		TextureRef    texture;
+		VertexDeclRef vdecl;
+		DataBufferRef indices;
+		LodRange lodRanges[lodsCount][StitchVariants];
+		eastl::vector<Chunk> chunks;
+		int      chunksX = 0;
+		int      chunksZ = 0;
+		int      hwidth = 0;
+		int      hheight = 0;
+		uint8_t* hmap = nullptr;
+		float    builtScaleH = 0.0f;
+		float    builtScaleV = 0.0f;
 
 		PhysScene::BodyUserData body;
 
@@ -102,6 +162,13 @@ namespace Oak
 		void ApplyProperties() override;
 		float GetHeight(int i, int j);
 		Math::Vector3 GetVecHeight(int i, int j);
+		int GetStitchedIndex(int x, int z, int step, int mask);
+		void BuildIndices();
+		bool IsChunkChanged(int cx, int cz, const uint8_t* prevHMap);
+		void BuildChunks(BuildJob& job);
+		void BuildRow(int cx, int cz, int z, VertexTri* v_tri, Math::Vector3& bbMin, Math::Vector3& bbMax);
+		void SelectLods(const Math::Vector3& camPos);
+		int GetStitchMask(int cx, int cz);
 		void LoadHMap(const char* hgt_name);
 		void Render(float dt);
 		void ShRender(float dt);
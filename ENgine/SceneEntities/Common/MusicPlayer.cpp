@@ -3,7 +3,7 @@
 
 namespace Oak
 {
-	CLASSREG(SceneEntity, MusicPlayer, "MusicPlayer")
+	CLASSREG_POOLED(SceneEntity, MusicPlayer, "MusicPlayer")
 
 	META_DATA_DESC(MusicPlayer)
 		BASE_SCENE_ENTITY_PROP(MusicPlayer)
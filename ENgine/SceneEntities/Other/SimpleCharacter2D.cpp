@@ -4,7 +4,7 @@
 
 namespace Oak
 {
-	CLASSREG(SceneEntity, SimpleCharacter2D, "SimpleCharacter2D")
+	CLASSREG_POOLED(SceneEntity, SimpleCharacter2D, "SimpleCharacter2D")
 
 	META_DATA_DESC(SimpleCharacter2D)
 		BASE_SCENE_ENTITY_PROP(SimpleCharacter2D)
@@ -183,7 +183,7 @@ namespace Oak
 
 	SimpleCharacter2D* SimpleCharacter2D::FindTarget()
 	{
-		eastl::vector<Scene::Group*> out_group;
+		FrameVector<Scene::Group*> out_group;
 		GetScene()->GetGroup(out_group, "SimpleCharacter2D");
 
 		for (auto group : out_group)
@@ -368,7 +368,7 @@ namespace Oak
 
 	void SimpleCharacter2D::MakeHit(Math::Vector2 pos, int damage)
 	{
-		eastl::vector<Scene::Group*> out_group;
+		FrameVector<Scene::Group*> out_group;
 		GetScene()->GetGroup(out_group, "SimpleCharacter2D");
 
 		for (auto group : out_group)
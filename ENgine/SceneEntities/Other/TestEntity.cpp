@@ -16,7 +16,7 @@ namespace Oak
 		TestEntity* jkl = (TestEntity*)owner;
 	}
 
-	CLASSREG(SceneEntity, TestEntity, "TestEntity")
+	CLASSREG_POOLED(SceneEntity, TestEntity, "TestEntity")
 
 	META_DATA_DESC(TestEntity)
 		BASE_SCENE_ENTITY_PROP(TestEntity)
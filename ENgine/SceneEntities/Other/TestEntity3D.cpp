@@ -4,7 +4,7 @@
 
 namespace Oak
 {
-	CLASSREG(SceneEntity, TestEntity3D, "TestEntity3D")
+	CLASSREG_POOLED(SceneEntity, TestEntity3D, "TestEntity3D")
 
 	META_DATA_DESC(TestEntity3D)
 		BASE_SCENE_ENTITY_PROP(TestEntity3D)
@@ -1,6 +1,9 @@
 
 #pragma once
 
+#include "Root/Memory/ObjectPool.h"
+#include <new>
+
 #define CLASSFACTORYDEF(baseClass) \
 class ClassFactory##baseClass \
 {\
@@ -40,6 +43,8 @@ public:\
 	virtual const char* GetName() = 0;\
 	virtual const char* GetShortName() = 0;\
 	virtual baseClass* Create(const char* file, int line) = 0;\
+	virtual void Destroy(baseClass* object) { delete object; };\
+	virtual ObjectPool* GetPool() { return nullptr; };\
 	static baseClass* Create(const char* name, const char* file, int line)\
 	{\
 		ClassFactory##baseClass* decl = Find(name);\
@@ -72,4 +77,19 @@ ClassFactory##shortClassName##baseClass classFactory##shortClassName##baseClass;
 
 #define CLASSREG(baseClass, className, shortName)\
 CLASSREGEX(baseClass, className, className, shortName)\
+CLASSREGEX_END(baseClass, className)
+
+#define CLASSREGEX_POOLED(baseClass, shortClassName, fullClassName, shortName)\
+class ClassFactory##shortClassName##baseClass : public ClassFactory##baseClass\
+{\
+	ObjectPool pool{ sizeof(fullClassName), alignof(fullClassName) };\
+public:\
+	virtual const char* GetName() { return #shortClassName; };\
+	virtual const char* GetShortName() { return shortName; };\
+	virtual baseClass* Create(const char* file, int line) { return new(pool.Alloc()) fullClassName(); };\
+	virtual void Destroy(baseClass* object) { fullClassName* ptr = static_cast<fullClassName*>(object); ptr->~fullClassName(); pool.Free(ptr); };\
+	virtual ObjectPool* GetPool() { return &pool; };
+
+#define CLASSREG_POOLED(baseClass, className, shortName)\
+CLASSREGEX_POOLED(baseClass, className, className, shortName)\
 CLASSREGEX_END(baseClass, className)
\ No newline at end of file
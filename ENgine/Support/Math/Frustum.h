@@ -0,0 +1,76 @@
+#pragma once
+
+#include "Vector3.h"
+#include "Vector4.h"
+#include "Matrix.h"
+
+namespace Oak::Math
+{
+	/**
+	\ingroup gr_code_common_math
+	*/
+
+	class Frustum
+	{
+	public:
+
+		enum class Result
+		{
+			Outside,
+			Intersect,
+			Inside
+		};
+
+		Vector4 planes[6];
+
+		void Build(const Matrix& viewProj)
+		{
+			// planes are taken from columns of view projection matrix, normals are looking inside
+			for (int i = 0; i < 4; i++)
+			{
+				float col0 = viewProj.m[i][0];
+				float col1 = viewProj.m[i][1];
+				float col2 = viewProj.m[i][2];
+				float col3 = viewProj.m[i][3];
+
+				planes[0].v[i] = col3 + col0;
+				planes[1].v[i] = col3 - col0;
+				planes[2].v[i] = col3 + col1;
+				planes[3].v[i] = col3 - col1;
+				planes[4].v[i] = col2;
+				planes[5].v[i] = col3 - col2;
+			}
+		}
+
+		Result CheckBox(const Vector3& bbMin, const Vector3& bbMax) const
+		{
+			Result result = Result::Inside;
+
+			for (int i = 0; i < 6; i++)
+			{
+				const Vector4& plane = planes[i];
+
+				// corners of a box which are the farthest and the nearest along a normal of a plane
+				Vector3 maxCorner(plane.x > 0.0f ? bbMax.x : bbMin.x, plane.y > 0.0f ? bbMax.y : bbMin.y, plane.z > 0.0f ? bbMax.z : bbMin.z);
+				Vector3 minCorner(plane.x > 0.0f ? bbMin.x : bbMax.x, plane.y > 0.0f ? bbMin.y : bbMax.y, plane.z > 0.0f ? bbMin.z : bbMax.z);
+
+				if (plane.x * maxCorner.x + plane.y * maxCorner.y + plane.z * maxCorner.z + plane.w < 0.0f)
+				{
+					return Result::Outside;
+				}
+
+				if (plane.x * minCorner.x + plane.y * minCorner.y + plane.z * minCorner.z + plane.w < 0.0f)
+				{
+					result = Result::Intersect;
+				}
+			}
+
+			return result;
+		}
+
+		bool IsBoxVisible(const Vector3& bbMin, const Vector3& bbMax) const
+		{
+			return CheckBox(bbMin, bbMax) != Result::Outside;
+		}
+	};
+}
@@ -1,5 +1,6 @@
 #include "Math.h"
 #include <stdlib.h>
+#include <float.h>
 
 namespace Oak::Math
 {
@@ -247,4 +248,20 @@ namespace Oak::Math
 
 		return true;
 	}
+
+	void TransformBBox(const Matrix& trans, Vector3& bbMin, Vector3& bbMax)
+	{
+		Vector3 corners[2] = { bbMin, bbMax };
+
+		bbMin = FLT_MAX;
+		bbMax = -FLT_MAX;
+
+		for (int i = 0; i < 8; i++)
+		{
+			Vector3 corner = trans.MulVertex(Vector3(corners[i & 1].x, corners[(i >> 1) & 1].y, corners[(i >> 2) & 1].z));
+
+			bbMin.Min(corner);
+			bbMax.Max(corner);
+		}
+	}
 }
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include "Vector3.h"
 #include "Vector4.h"
 #include "Quaternion.h"
+#include "Frustum.h"
 
 /**
 \ingroup gr_code_common_math
@@ -29,4 +30,5 @@ namespace Oak::Math
 	bool IntersectTrianglrRay(Vector3 v1, Vector3 v2, Vector3 v3, Vector3 orig, Vector3 dir, float distance);
 	bool IntersectPlaneRay(Math::Vector3 planeP, Math::Vector3 planeN, Math::Vector3 rayP, Math::Vector3 rayD, Math::Vector3& intersection);
 	bool IsInsideTriangle(Math::Vector2 s, Math::Vector2 a, Math::Vector2 b, Math::Vector2 c);
+	void TransformBBox(const Matrix& trans, Vector3& bbMin, Vector3& bbMax);
 }
\ No newline at end of file
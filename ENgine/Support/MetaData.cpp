@@ -229,6 +229,12 @@ namespace Oak
 				SceneEntityRef* ref = (SceneEntityRef*)prop.value;
 				ref->entity = scene->FindEntity(ref->uid);
 			}
+			else
+			if (prop.type == Type::AssetAnimGraph2D)
+			{
+				// graph is set to default node only after asset was loaded on a main thread
+				reinterpret_cast<AssetAnimGraph2DRef*>(prop.value)->Reset();
+			}
 		}
 	}
 
@@ -318,6 +324,180 @@ namespace Oak
 		}
 	}
 
+	void MetaData::Load(BinaryReader& reader)
+	{
+		for (auto& prop : properties)
+		{
+			if (prop.type == Type::Boolean)
+			{
+				reader.Read(*((bool*)prop.value));
+			}
+			else
+			if (prop.type == Type::Integer || prop.type == Type::Enum)
+			{
+				reader.Read(*((int*)prop.value));
+			}
+			else
+			if (prop.type == Type::Float)
+			{
+				reader.Read(*((float*)prop.value));
+			}
+			else
+			if (prop.type == Type::String || prop.type == Type::EnumString || prop.type == Type::FileName)
+			{
+				reader.Read(*((eastl::string*)prop.value));
+			}
+			else
+			if (prop.type == Type::Color)
+			{
+				reader.Read(*((Oak::Color*)prop.value));
+			}
+			else
+			if (prop.type == Type::AssetTexture)
+			{
+				reinterpret_cast<AssetTextureRef*>(prop.value)->LoadData(reader);
+			}
+			else
+			if (prop.type == Type::AssetAnimGraph2D)
+			{
+				reinterpret_cast<AssetAnimGraph2DRef*>(prop.value)->LoadData(reader);
+			}
+			else
+			if (prop.type == Type::Transform)
+			{
+				((Transform*)prop.value)->Load(reader);
+			}
+			else
+			if (prop.type == Type::SceneEntity)
+			{
+				reader.Read(((SceneEntityRef*)prop.value)->uid);
+			}
+			else
+			if (prop.type == Type::Array)
+			{
+				int count = 0;
+				reader.Read(count);
+
+				if (reader.IsFailed())
+				{
+					return;
+				}
+
+				prop.adapter->Resize(count);
+
+				for (int i = 0; i < count; i++)
+				{
+					prop.adapter->GetMetaData()->Prepare(prop.adapter->GetItem(i), root);
+					prop.adapter->GetMetaData()->Load(reader);
+				}
+			}
+		}
+	}
+
+	#ifdef OAK_EDITOR
+	void MetaData::Save(BinaryWriter& writer)
+	{
+		for (auto& prop : properties)
+		{
+			if (prop.type == Type::Boolean)
+			{
+				writer.Write(*((bool*)prop.value));
+			}
+			else
+			if (prop.type == Type::Integer || prop.type == Type::Enum)
+			{
+				writer.Write(*((int*)prop.value));
+			}
+			else
+			if (prop.type == Type::Float)
+			{
+				writer.Write(*((float*)prop.value));
+			}
+			else
+			if (prop.type == Type::String || prop.type == Type::EnumString || prop.type == Type::FileName)
+			{
+				writer.Write(*((eastl::string*)prop.value));
+			}
+			else
+			if (prop.type == Type::Color)
+			{
+				writer.Write(*((Oak::Color*)prop.value));
+			}
+			else
+			if (prop.type == Type::AssetTexture)
+			{
+				reinterpret_cast<AssetTextureRef*>(prop.value)->SaveData(writer);
+			}
+			else
+			if (prop.type == Type::AssetAnimGraph2D)
+			{
+				reinterpret_cast<AssetAnimGraph2DRef*>(prop.value)->SaveData(writer);
+			}
+			else
+			if (prop.type == Type::Transform)
+			{
+				((Transform*)prop.value)->Save(writer);
+			}
+			else
+			if (prop.type == Type::SceneEntity)
+			{
+				writer.Write(((SceneEntityRef*)prop.value)->uid);
+			}
+			else
+			if (prop.type == Type::Array)
+			{
+				int count = prop.adapter->GetSize();
+				writer.Write(count);
+
+				for (int i = 0; i < count; i++)
+				{
+					prop.adapter->GetMetaData()->Prepare(prop.adapter->GetItem(i), root);
+					prop.adapter->GetMetaData()->Save(writer);
+				}
+			}
+		}
+	}
+	#endif
+
+	uint32_t MetaData::GetLayoutHash()
+	{
+		if (!inited)
+		{
+			Init();
+			inited = true;
+		}
+
+		// FNV-1a over names and types of properties
+		uint32_t hash = 2166136261u;
+
+		auto combine = [&hash](const void* data, size_t size)
+		{
+			for (size_t i = 0; i < size; i++)
+			{
+				hash = (hash ^ ((const uint8_t*)data)[i]) * 16777619u;
+			}
+		};
+
+		for (auto& prop : properties)
+		{
+			if (prop.type == Type::Callback)
+			{
+				continue;
+			}
+
+			combine(prop.name.c_str(), prop.name.size());
+			combine(&prop.type, sizeof(prop.type));
+
+			if (prop.type == Type::Array)
+			{
+				uint32_t elemHash = prop.adapter->GetMetaData()->GetLayoutHash();
+				combine(&elemHash, sizeof(elemHash));
+			}
+		}
+
+		return hash;
+	}
+
 	void MetaData::Copy(void* source, eastl::vector<Property>& sourceProperties)
 	{
 		for (auto& prop : properties)
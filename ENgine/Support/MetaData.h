@@ -5,6 +5,8 @@
 #include "Support/Delegate.h"
 #include "Root/Files/JSONReader.h"
 #include "Root/Files/JSONWriter.h"
+#include "Root/Files/BinaryReader.h"
+#include "Root/Files/BinaryWriter.h"
 
 /**
 \ingroup gr_code_common
@@ -170,6 +172,29 @@ namespace Oak
 		void PostLoad(Scene* scene);
 		void Save(JsonWriter& writer);
 
+		/**
+		\brief Load values of properties from a binary file. Values are expected in order of properties.
+
+		\param[in] reader Helper class for reading binary file
+		*/
+		void Load(BinaryReader& reader);
+
+		#ifdef OAK_EDITOR
+		/**
+		\brief Save values of properties into a binary file
+
+		\param[in] writer Helper class for writing binary file
+		*/
+		void Save(BinaryWriter& writer);
+		#endif
+
+		/**
+		\brief Get hash of names and types of properties. Binary data can be loaded only if hash wasn't changed.
+
+		\return Hash of layout of properties
+		*/
+		uint32_t GetLayoutHash();
+
 		void Copy(void* source, eastl::vector<Property>& sourceProperties);
 
 		#ifndef DOXYGEN_SKIP
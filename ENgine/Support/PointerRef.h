@@ -101,9 +101,7 @@ namespace Oak
 
 			if (ptr)
 			{
-				ptr->refCounter--;
-
-				if (ptr->refCounter == 0)
+				if (--ptr->refCounter == 0)
 				{
 					ptr->Release();
 				}
@@ -52,7 +52,7 @@ namespace IO
 		* @param is : the input stream from which to load the system
 		* @return the loaded system or NULL if loading failed
 		*/
-        Ref<System> load(std::istream& is, const std::string &path = 0) const;
+        Ref<System> load(std::istream& is, const std::string &path = "") const;
 
 		/**
 		* @brief Loads a system from a file
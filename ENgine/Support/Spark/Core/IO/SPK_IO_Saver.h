@@ -50,7 +50,7 @@ namespace IO
 		* @param os : the output stream to save the system to
 		* @return true if the system has been successfully saved, false if not
 		*/
-        bool save(std::ostream& os, const Ref<System>& system, const std::string &filepath=0) const;
+        bool save(std::ostream& os, const Ref<System>& system, const std::string &filepath = "") const;
 
 		/**
 		* @brief Saves a system in a file
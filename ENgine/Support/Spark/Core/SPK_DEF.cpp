@@ -23,6 +23,7 @@
 
 #include <ctime>
 #include <limits>
+#include <atomic>
 
 #include <SPARK.h>
 #include "Extensions/Zones/SPK_Point.h" // for default zone
@@ -39,12 +40,6 @@ namespace SPK
 	SPKContext::SPKContext() :
 		defaultZone()
 	{
-		// Inits the random seed
-		randomSeed = static_cast<unsigned int>(std::time(NULL));
-		// little tweak to ensure the randomSeed is uniformly distributed along all the range
-		for (size_t i = 0; i < 2; ++i)
-			randomSeed = generateRandom(static_cast<unsigned int>(1),std::numeric_limits<unsigned int>::max());
-
 		// Registers all core objects for loading
 		// registerCoreForLoading();
 	}
@@ -61,6 +56,23 @@ namespace SPK
 		defaultZone.reset();
 	}
 
+	unsigned int& SPKContext::getRandomSeed()
+	{
+		static std::atomic<unsigned int> nbThreads(0);
+		static thread_local unsigned int randomSeed = 0;
+
+		if (randomSeed == 0)
+		{
+			// Inits the random seed, threads get different seeds even if they start at the same time
+			randomSeed = (static_cast<unsigned int>(std::time(NULL)) + 0x9E3779B9u * ++nbThreads) | 1;
+			// little tweak to ensure the randomSeed is uniformly distributed along all the range
+			for (size_t i = 0; i < 2; ++i)
+				randomSeed = get().generateRandom(static_cast<unsigned int>(1),std::numeric_limits<unsigned int>::max());
+		}
+
+		return randomSeed;
+	}
+
 	const Ref<Zone>& SPKContext::getDefaultZone()
 	{
 		if (!defaultZone)
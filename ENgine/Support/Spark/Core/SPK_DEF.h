@@ -193,7 +193,9 @@ namespace SPK
 		static SPKContext instance;
 
 		Ref<Zone> defaultZone;
-		unsigned int randomSeed;
+
+		// Each thread has its own seed, so particles can be generated on several threads at once
+		static unsigned int& getRandomSeed();
 
 		SPKContext();
 		~SPKContext();
@@ -210,6 +212,8 @@ namespace SPK
 	template<typename T>
 	inline T SPKContext::generateRandom(const T& min,const T& max)
     {
+		unsigned int& randomSeed = getRandomSeed();
+
 		// optimized standard minimal
 		long tmp0 = 16807L * (randomSeed & 0xFFFFL);
         long tmp1 = 16807L * (randomSeed >> 16);
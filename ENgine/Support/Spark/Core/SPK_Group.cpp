@@ -168,21 +168,15 @@ namespace SPK
 		int nbBorn = nbAutoBorn + nbManualBorn;
 
 		// Updates the age of the particles function of the delta time
-		for (int i = 0; i < particleData.nbParticles; ++i)
-			particleData.ages[i] += deltaTime;
+		addToArray(particleData.ages,deltaTime,particleData.nbParticles);
 
 		// Computes the energy of the particles (if they are not immortal)
 		if (!immortal)
-			for (int i = 0; i < particleData.nbParticles; ++i)
-				particleData.energies[i] = 1.0f - particleData.ages[i] / particleData.lifeTimes[i];
+			computeEnergies(particleData.energies,particleData.ages,particleData.lifeTimes,particleData.nbParticles);
 
 		// Updates the position of particles function of their velocity
 		if (!still)
-			for (int i = 0; i < particleData.nbParticles; ++i)
-			{
-				particleData.oldPositions[i] = particleData.positions[i];
-				particleData.positions[i] += particleData.velocities[i] * deltaTime;
-			}
+			integratePositions(particleData.positions,particleData.oldPositions,particleData.velocities,deltaTime,particleData.nbParticles);
 
 		// Interpolates the parameters
 		if (colorInterpolator.obj)
@@ -242,10 +236,7 @@ namespace SPK
 
 		// Computes the distance of particles from the camera
 		if (distanceComputationEnabled)
-		{
-			for (int i = 0; i < particleData.nbParticles; ++i)
-				particleData.sqrDists[i] = getSqrDist(particleData.positions[i],system->getCameraPosition());
-		}
+			computeSqrDists(particleData.sqrDists,particleData.positions,system->getCameraPosition(),particleData.nbParticles);
 
 		emptyBufferedParticles();
 
@@ -608,8 +599,28 @@ namespace SPK
 
 	void Group::sortParticles()
 	{
-		if (sortingEnabled)
-			sortParticles(0,particleData.nbParticles - 1);
+		if (!sortingEnabled || particleData.nbParticles < 2)
+			return;
+
+		const int nb = particleData.nbParticles;
+		const float* sqrDists = particleData.sqrDists;
+
+		// Particles move slowly between steps so they are often still sorted
+		int firstUnsorted = 1;
+		while (firstUnsorted < nb && sqrDists[firstUnsorted - 1] >= sqrDists[firstUnsorted])
+			++firstUnsorted;
+		if (firstUnsorted == nb)
+			return;
+
+		// Order is sorted by indices first, so each particle is moved only once
+		sortOrder.resize(nb);
+		for (int i = 0; i < nb; ++i)
+			sortOrder[i] = i;
+
+		if (!insertionSortOrder(firstUnsorted))
+			radixSortOrder();
+
+		permuteParticles();
 	}
 
 	void Group::computeAABB()
@@ -631,27 +642,115 @@ namespace SPK
 			}
 	}
 
-	void Group::sortParticles(int start,int end)
+	bool Group::insertionSortOrder(int start)
+	{
+		// Insertion sort is linear for nearly sorted particles, it gives up when particles moved too much
+		static const int MAX_SHIFTS_PER_PARTICLE = 8;
+
+		const int nb = particleData.nbParticles;
+		const float* sqrDists = particleData.sqrDists;
+		int* order = &sortOrder[0];
+		int shiftsLeft = nb * MAX_SHIFTS_PER_PARTICLE;
+
+		for (int i = start; i < nb; ++i)
+		{
+			int index = order[i];
+			float sqrDist = sqrDists[index];
+			int j = i;
+			while (j > 0 && sqrDists[order[j - 1]] < sqrDist)
+			{
+				order[j] = order[j - 1];
+				--j;
+			}
+			order[j] = index;
+
+			shiftsLeft -= i - j;
+			if (shiftsLeft < 0)
+				return false;
+		}
+
+		return true;
+	}
+
+	void Group::radixSortOrder()
 	{
-		// quick sort implementation (can be optimized)
-		if (start < end)
+		const int nb = particleData.nbParticles;
+		sortKeys.resize(nb);
+		sortKeysBuffer.resize(nb);
+		sortBuffer0.resize(nb);
+
+		// Bits of positive floats are ordered as floats, they are inverted to sort from far to near
+		for (int i = 0; i < nb; ++i)
 		{
-			int i = start - 1;
-			int j = end + 1;
-			float pivot = particleData.sqrDists[(start + end) >> 1];
-			while (true)
+			unsigned int bits;
+			std::memcpy(&bits,particleData.sqrDists + i,sizeof(bits));
+			sortKeys[i] = ~bits;
+			sortOrder[i] = i;
+		}
+
+		unsigned int* keys = &sortKeys[0];
+		unsigned int* keysBuffer = &sortKeysBuffer[0];
+		int* order = &sortOrder[0];
+		int* orderBuffer = &sortBuffer0[0];
+
+		for (int shift = 0; shift < 32; shift += 8)
+		{
+			int offsets[256] = {0};
+			for (int i = 0; i < nb; ++i)
+				++offsets[(keys[i] >> shift) & 0xFF];
+
+			// Pass is skipped when all keys have the same byte
+			if (offsets[(keys[0] >> shift) & 0xFF] == nb)
+				continue;
+
+			int offset = 0;
+			for (int i = 0; i < 256; ++i)
 			{
-				do ++i;
-				while (particleData.sqrDists[i] > pivot);
-				do --j;
-				while (particleData.sqrDists[j] < pivot);
-				if (i < j)
-					swapParticles(i,j);
-				else break;
+				int count = offsets[i];
+				offsets[i] = offset;
+				offset += count;
 			}
 
-			sortParticles(start,j);
-			sortParticles(j + 1,end);
+			for (int i = 0; i < nb; ++i)
+			{
+				int dest = offsets[(keys[i] >> shift) & 0xFF]++;
+				keysBuffer[dest] = keys[i];
+				orderBuffer[dest] = order[i];
+			}
+
+			std::swap(keys,keysBuffer);
+			std::swap(order,orderBuffer);
+		}
+
+		if (order != &sortOrder[0])
+			std::memcpy(&sortOrder[0],order,nb * sizeof(int));
+	}
+
+	void Group::permuteParticles()
+	{
+		// Particles are put in order by at most nb - 1 swaps, locations of swapped particles are tracked
+		const int nb = particleData.nbParticles;
+		sortBuffer0.resize(nb);
+		sortBuffer1.resize(nb);
+
+		int* locations = &sortBuffer0[0];
+		int* particlesAt = &sortBuffer1[0];
+		for (int i = 0; i < nb; ++i)
+			locations[i] = particlesAt[i] = i;
+
+		for (int i = 0; i < nb; ++i)
+		{
+			int particle = sortOrder[i];
+			int location = locations[particle];
+			if (location != i)
+			{
+				swapParticles(i,location);
+				int moved = particlesAt[i];
+				particlesAt[location] = moved;
+				locations[moved] = location;
+				particlesAt[i] = particle;
+				locations[particle] = i;
+			}
 		}
 	}
 
@@ -785,6 +884,15 @@ namespace SPK
 		nbBufferedParticles = 0;
 	}
 
+	void Group::reset()
+	{
+		empty();
+		emptyBufferedParticles();
+
+		for (std::vector<Ref<Emitter> >::const_iterator it = emitters.begin(); it != emitters.end(); ++it)
+			(*it)->resetTank();
+	}
+
 	inline void Group::prepareAdditionnalData()
 	{
 		if (renderer.obj)
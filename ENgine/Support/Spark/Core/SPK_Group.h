@@ -125,6 +125,7 @@ namespace SPK
 
 		void reallocate(int capacity);
 		void empty();
+		void reset();
 
 		void addEmitter(const Ref<Emitter>& emitter);
 		void removeEmitter(const Ref<Emitter>& emitter);
@@ -151,6 +152,9 @@ namespace SPK
 		const void* getPositionAddress() const;
 		const void* getVelocityAddress() const;
 		const void* getParamAddress(Param param) const;
+		const void* getAgeAddress() const;
+		const void* getEnergyAddress() const;
+		void* getVelocityAddressNC();
 
 		void setRadius(float radius);
 		void setGraphicalRadius(float radius);
@@ -575,6 +579,13 @@ namespace SPK
 
 		Octree* octree;
 
+		// Buffers used by sorting, they are kept to avoid allocations at each step
+		std::vector<int> sortOrder;
+		std::vector<int> sortBuffer0;
+		std::vector<int> sortBuffer1;
+		std::vector<unsigned int> sortKeys;
+		std::vector<unsigned int> sortKeysBuffer;
+
 		Group(const Ref<System>& system = SPK_NULL_REF, int capacity = 100);
 		Group(const Group& group);
 
@@ -592,7 +603,9 @@ namespace SPK
 		DataSet* attachDataSet(DataHandler* dataHandler);
 		void detachDataSet(DataSet* dataHandler);
 
-		void sortParticles(int start,int end);
+		bool insertionSortOrder(int start);
+		void radixSortOrder();
+		void permuteParticles();
 		virtual void propagateUpdateTransform() override;
 
 		void sortParticles();
@@ -820,6 +833,21 @@ namespace SPK
 		return particleData.parameters[param];
 	}
 
+	inline const void* Group::getAgeAddress() const
+	{
+		return particleData.ages;
+	}
+
+	inline const void* Group::getEnergyAddress() const
+	{
+		return particleData.energies;
+	}
+
+	inline void* Group::getVelocityAddressNC()
+	{
+		return particleData.velocities;
+	}
+
 	inline const Vector3D& Group::getAABBMin() const
 	{
 		return AABBMin;
@@ -0,0 +1,236 @@
+//
+// SPARK particle engine
+//
+// Copyright (C) 2008-2011 - Julien Fryer - julienfryer@gmail.com
+// Copyright (C) 2017 - Frederic Martin - fredakilla@gmail.com
+//
+// This software is provided 'as-is', without any express or implied
+// warranty.  In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+//
+
+#ifndef H_SPK_KERNELS
+#define H_SPK_KERNELS
+
+#include <cstddef>
+
+// SSE2 is used when the target has it (always the case on x64), SPK_NO_SIMD forces scalar kernels
+#if !defined(SPK_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define SPK_SSE
+#include <emmintrin.h>
+#endif
+
+namespace SPK
+{
+	/**
+	* @brief Adds a value to each element of an array
+	* @param data : the array
+	* @param value : the value to add
+	* @param nb : the number of elements
+	*/
+	inline void addToArray(float* data,float value,size_t nb)
+	{
+		size_t i = 0;
+#ifdef SPK_SSE
+		const __m128 v = _mm_set1_ps(value);
+		for (; i + 4 <= nb; i += 4)
+			_mm_storeu_ps(data + i,_mm_add_ps(_mm_loadu_ps(data + i),v));
+#endif
+		for (; i < nb; ++i)
+			data[i] += value;
+	}
+
+	/**
+	* @brief Computes energies of particles as 1 - age / lifeTime
+	* @param energies : the array of energies to fill
+	* @param ages : the array of ages
+	* @param lifeTimes : the array of life times
+	* @param nb : the number of particles
+	*/
+	inline void computeEnergies(float* energies,const float* ages,const float* lifeTimes,size_t nb)
+	{
+		size_t i = 0;
+#ifdef SPK_SSE
+		const __m128 one = _mm_set1_ps(1.0f);
+		for (; i + 4 <= nb; i += 4)
+			_mm_storeu_ps(energies + i,_mm_sub_ps(one,_mm_div_ps(_mm_loadu_ps(ages + i),_mm_loadu_ps(lifeTimes + i))));
+#endif
+		for (; i < nb; ++i)
+			energies[i] = 1.0f - ages[i] / lifeTimes[i];
+	}
+
+	/**
+	* @brief Saves positions of particles and moves them by their velocities
+	*
+	* Arrays of Vector3D are processed as flat arrays of floats, as the integration is the same for each coordinate.
+	*
+	* @param positions : the array of positions
+	* @param oldPositions : the array where previous positions are stored
+	* @param velocities : the array of velocities
+	* @param deltaTime : the time step
+	* @param nb : the number of particles
+	*/
+	inline void integratePositions(Vector3D* positions,Vector3D* oldPositions,const Vector3D* velocities,float deltaTime,size_t nb)
+	{
+		float* pos = &positions[0].x;
+		float* oldPos = &oldPositions[0].x;
+		const float* vel = &velocities[0].x;
+		size_t nbFloats = nb * 3;
+
+		size_t i = 0;
+#ifdef SPK_SSE
+		const __m128 dt = _mm_set1_ps(deltaTime);
+		for (; i + 4 <= nbFloats; i += 4)
+		{
+			__m128 p = _mm_loadu_ps(pos + i);
+			_mm_storeu_ps(oldPos + i,p);
+			_mm_storeu_ps(pos + i,_mm_add_ps(p,_mm_mul_ps(_mm_loadu_ps(vel + i),dt)));
+		}
+#endif
+		for (; i < nbFloats; ++i)
+		{
+			oldPos[i] = pos[i];
+			pos[i] += vel[i] * deltaTime;
+		}
+	}
+
+	/**
+	* @brief Adds a vector to each element of an array of vectors
+	* @param data : the array of vectors
+	* @param v : the vector to add
+	* @param nb : the number of vectors
+	*/
+	inline void addToVectors(Vector3D* data,const Vector3D& v,size_t nb)
+	{
+		float* flat = &data[0].x;
+
+		size_t i = 0;
+#ifdef SPK_SSE
+		// 4 vectors are 3 registers and the pattern of the added vector is rotated in each of them
+		const __m128 v0 = _mm_setr_ps(v.x,v.y,v.z,v.x);
+		const __m128 v1 = _mm_setr_ps(v.y,v.z,v.x,v.y);
+		const __m128 v2 = _mm_setr_ps(v.z,v.x,v.y,v.z);
+		for (; i + 4 <= nb; i += 4)
+		{
+			float* ptr = flat + i * 3;
+			_mm_storeu_ps(ptr,_mm_add_ps(_mm_loadu_ps(ptr),v0));
+			_mm_storeu_ps(ptr + 4,_mm_add_ps(_mm_loadu_ps(ptr + 4),v1));
+			_mm_storeu_ps(ptr + 8,_mm_add_ps(_mm_loadu_ps(ptr + 8),v2));
+		}
+#endif
+		for (; i < nb; ++i)
+			data[i] += v;
+	}
+
+	/**
+	* @brief Computes square distances from vectors to a point
+	* @param sqrDists : the array of square distances to fill
+	* @param data : the array of vectors
+	* @param point : the point
+	* @param nb : the number of vectors
+	*/
+	inline void computeSqrDists(float* sqrDists,const Vector3D* data,const Vector3D& point,size_t nb)
+	{
+		const float* flat = &data[0].x;
+
+		size_t i = 0;
+#ifdef SPK_SSE
+		const __m128 p0 = _mm_setr_ps(point.x,point.y,point.z,point.x);
+		const __m128 p1 = _mm_setr_ps(point.y,point.z,point.x,point.y);
+		const __m128 p2 = _mm_setr_ps(point.z,point.x,point.y,point.z);
+		for (; i + 4 <= nb; i += 4)
+		{
+			const float* ptr = flat + i * 3;
+			__m128 a = _mm_sub_ps(_mm_loadu_ps(ptr),p0);		// x0 y0 z0 x1
+			__m128 b = _mm_sub_ps(_mm_loadu_ps(ptr + 4),p1);	// y1 z1 x2 y2
+			__m128 c = _mm_sub_ps(_mm_loadu_ps(ptr + 8),p2);	// z2 x3 y3 z3
+			a = _mm_mul_ps(a,a);
+			b = _mm_mul_ps(b,b);
+			c = _mm_mul_ps(c,c);
+
+			// transposes squares into x, y and z of 4 vectors
+			__m128 t = _mm_shuffle_ps(b,c,_MM_SHUFFLE(1,0,3,2));
+			__m128 x = _mm_shuffle_ps(a,t,_MM_SHUFFLE(3,0,3,0));
+			__m128 y = _mm_shuffle_ps(_mm_shuffle_ps(a,b,_MM_SHUFFLE(0,0,1,1)),_mm_shuffle_ps(b,c,_MM_SHUFFLE(2,2,3,3)),_MM_SHUFFLE(2,0,2,0));
+			__m128 z = _mm_shuffle_ps(_mm_shuffle_ps(a,b,_MM_SHUFFLE(1,1,2,2)),_mm_shuffle_ps(c,c,_MM_SHUFFLE(3,3,0,0)),_MM_SHUFFLE(2,0,2,0));
+
+			_mm_storeu_ps(sqrDists + i,_mm_add_ps(x,_mm_add_ps(y,z)));
+		}
+#endif
+		for (; i < nb; ++i)
+			sqrDists[i] = getSqrDist(data[i],point);
+	}
+
+	/**
+	* @brief Computes x of particles in a graph as (bias + sign * base + offset) * scale
+	* @param x : the array to fill
+	* @param base : the array of values from which x is computed
+	* @param bias : the bias added to base values
+	* @param sign : the sign of base values
+	* @param offsets : the array of offsets of particles
+	* @param scales : the array of scales of particles
+	* @param nb : the number of particles
+	*/
+	inline void computeGraphX(float* x,const float* base,float bias,float sign,const float* offsets,const float* scales,size_t nb)
+	{
+		size_t i = 0;
+#ifdef SPK_SSE
+		const __m128 b = _mm_set1_ps(bias);
+		const __m128 s = _mm_set1_ps(sign);
+		for (; i + 4 <= nb; i += 4)
+		{
+			__m128 v = _mm_add_ps(b,_mm_mul_ps(s,_mm_loadu_ps(base + i)));
+			_mm_storeu_ps(x + i,_mm_mul_ps(_mm_add_ps(v,_mm_loadu_ps(offsets + i)),_mm_loadu_ps(scales + i)));
+		}
+#endif
+		for (; i < nb; ++i)
+			x[i] = (bias + sign * base[i] + offsets[i]) * scales[i];
+	}
+
+	/**
+	* @brief Wraps x of particles into a range of a looping graph
+	* @param x : the array of x
+	* @param beginX : the x of the first entry of a graph
+	* @param rangeX : the distance between the first and the last entries of a graph
+	* @param nb : the number of particles
+	*/
+	inline void wrapGraphX(float* x,float beginX,float rangeX,size_t nb)
+	{
+		size_t i = 0;
+#ifdef SPK_SSE
+		const __m128 begin = _mm_set1_ps(beginX);
+		const __m128 range = _mm_set1_ps(rangeX);
+		const __m128 one = _mm_set1_ps(1.0f);
+		const __m128 zero = _mm_setzero_ps();
+		for (; i + 4 <= nb; i += 4)
+		{
+			__m128 v = _mm_div_ps(_mm_sub_ps(_mm_loadu_ps(x + i),begin),range);
+			v = _mm_sub_ps(v,_mm_cvtepi32_ps(_mm_cvttps_epi32(v)));
+			v = _mm_add_ps(v,_mm_and_ps(_mm_cmplt_ps(v,zero),one));
+			_mm_storeu_ps(x + i,_mm_add_ps(begin,_mm_mul_ps(v,range)));
+		}
+#endif
+		for (; i < nb; ++i)
+		{
+			float newX = (x[i] - beginX) / rangeX;
+			newX -= static_cast<int>(newX);
+			if (newX < 0.0f)
+				newX = 1.0f + newX;
+			x[i] = beginX + newX * rangeX;
+		}
+	}
+}
+
+#endif
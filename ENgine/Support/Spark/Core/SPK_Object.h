@@ -26,6 +26,7 @@
 
 #include <string>
 #include <map>
+#include <atomic>
 
 #define SPK_START_DESCRIPTION \
 \
@@ -210,7 +211,8 @@ namespace SPK
 
 		std::string name;
 
-		unsigned int nbReferences;
+		// atomic as shared objects are referenced by systems which are updated on several threads
+		std::atomic<unsigned int> nbReferences;
 
 		const SharePolicy SHARE_POLICY;
 		bool shared;
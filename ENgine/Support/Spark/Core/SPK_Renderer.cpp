@@ -37,4 +37,29 @@ namespace SPK
 	{
 		SPK_LOG_INFO("VBO hint is not yet considered");
 	}
+
+	void Renderer::innerImport(const IO::Descriptor& descriptor)
+	{
+		SPKObject::innerImport(descriptor);
+
+		const IO::Attribute* attrib = NULL;
+
+		if ((attrib = descriptor.getAttributeWithValue("active")))
+			setActive(attrib->getValue<bool>());
+
+		if ((attrib = descriptor.getAttributeWithValue("rendering options")))
+			renderingOptionsMask = attrib->getValue<int32>();
+
+		if ((attrib = descriptor.getAttributeWithValue("alpha threshold")))
+			setAlphaTestThreshold(attrib->getValue<float>());
+	}
+
+	void Renderer::innerExport(IO::Descriptor& descriptor) const
+	{
+		SPKObject::innerExport(descriptor);
+
+		descriptor.getAttribute("active")->setValueOptionalOnTrue(isActive());
+		descriptor.getAttribute("rendering options")->setValue(static_cast<int32>(renderingOptionsMask));
+		descriptor.getAttribute("alpha threshold")->setValue(getAlphaTestThreshold());
+	}
 }
@@ -120,6 +120,9 @@ namespace SPK
 
 		Renderer(bool NEEDS_DATASET);
 
+		virtual void innerImport(const IO::Descriptor& descriptor) override;
+		virtual void innerExport(IO::Descriptor& descriptor) const override;
+
 	private :
 
 		// Rendering hints
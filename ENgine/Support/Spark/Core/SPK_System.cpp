@@ -28,13 +28,13 @@
 
 namespace SPK
 {
-	StepMode System::stepMode(STEP_MODE_REAL);
-	float System::constantStep(0.0f);
-	float System::minStep(0.0f);
-	float System::maxStep(0.0f);
+	std::atomic<StepMode> System::stepMode(STEP_MODE_REAL);
+	std::atomic<float> System::constantStep(0.0f);
+	std::atomic<float> System::minStep(0.0f);
+	std::atomic<float> System::maxStep(0.0f);
 
-	bool System::clampStepEnabled(false);
-	float System::clampStep(1.0f);
+	std::atomic<bool> System::clampStepEnabled(false);
+	std::atomic<float> System::clampStep(1.0f);
 
 	System::System(bool initialize) :
 		Transformable(SHARE_POLICY_TRUE),
@@ -141,25 +141,33 @@ namespace SPK
 
 		bool alive = true;
 
-		if ((clampStepEnabled)&&(deltaTime > clampStep))
-			deltaTime = clampStep;
+		// Takes a snapshot of the step settings as they can be changed from another thread
+		StepMode curStepMode = stepMode.load(std::memory_order_acquire);
+		float curConstantStep = constantStep.load(std::memory_order_relaxed);
+		float curMinStep = minStep.load(std::memory_order_relaxed);
+		float curMaxStep = maxStep.load(std::memory_order_relaxed);
+		bool curClampStepEnabled = clampStepEnabled.load(std::memory_order_acquire);
+		float curClampStep = clampStep.load(std::memory_order_relaxed);
 
-		if (stepMode != STEP_MODE_REAL)
+		if ((curClampStepEnabled)&&(deltaTime > curClampStep))
+			deltaTime = curClampStep;
+
+		if (curStepMode != STEP_MODE_REAL)
 		{
 			deltaTime += deltaStep;
 
 			float updateStep;
-			if (stepMode == STEP_MODE_ADAPTIVE)
+			if (curStepMode == STEP_MODE_ADAPTIVE)
 			{
-				if (deltaTime > maxStep)
-					updateStep = maxStep;
-				else if (deltaTime < minStep)
-					updateStep = minStep;
+				if (deltaTime > curMaxStep)
+					updateStep = curMaxStep;
+				else if (deltaTime < curMinStep)
+					updateStep = curMinStep;
 				else
 					updateStep = deltaTime;
 			}
 			else
-				updateStep = constantStep;
+				updateStep = curConstantStep;
 
 			while(deltaTime >= updateStep)
 			{
@@ -221,6 +229,15 @@ namespace SPK
 			(*it)->initData();
 	}
 
+	void System::reset()
+	{
+		for (std::vector<Ref<Group> >::const_iterator it = groups.begin(); it != groups.end(); ++it)
+			(*it)->reset();
+
+		deltaStep = 0.0f;
+		active = true;
+	}
+
 	Ref<SPKObject> System::findByName(const std::string& name)
 	{
 		Ref<SPKObject> object = SPKObject::findByName(name);
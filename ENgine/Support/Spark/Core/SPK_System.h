@@ -25,6 +25,7 @@
 #define H_SPK_SYSTEM
 
 #include <vector>
+#include <atomic>
 
 // This define helps implement a wrapper for SPK::System by redirecting the methods
 #define SPK_IMPLEMENT_SYSTEM_WRAPPER \
@@ -286,6 +287,16 @@ namespace SPK
 		void initialize();
 		bool isInitialized() const;
 
+		/**
+		* @brief Restarts emission of the system
+		*
+		* Particles of all groups are removed and tanks of emitters are refilled.<br>
+		* Other states, like active flags of emitters and modifiers, are not restored, so it only suits systems
+		* which are not changed after initialization.<br>
+		* Buffers of groups are kept, so a finished system can be restarted without any allocation.
+		*/
+		void reset();
+
 		virtual Ref<SPKObject> findByName(const std::string& name) override;
 
 	//protected :
@@ -304,14 +315,15 @@ namespace SPK
 
 		Vector3D cameraPosition;
 
-		// Step mode
-		static StepMode stepMode;
-		static float constantStep;
-		static float minStep;
-		static float maxStep;
+		// Step mode, settings are atomic as systems can be updated on several threads
+		// Values are stored before the mode (or the clamp flag) so a reader which sees the new mode sees its values
+		static std::atomic<StepMode> stepMode;
+		static std::atomic<float> constantStep;
+		static std::atomic<float> minStep;
+		static std::atomic<float> maxStep;
 
-		static bool clampStepEnabled;
-		static float clampStep;
+		static std::atomic<bool> clampStepEnabled;
+		static std::atomic<float> clampStep;
 
 		float deltaStep;
 
@@ -381,31 +393,31 @@ namespace SPK
 
 	inline void System::setClampStep(bool enableClampStep,float clamp)
 	{
-		clampStepEnabled = enableClampStep;
-		clampStep = clamp;
+		clampStep.store(clamp,std::memory_order_relaxed);
+		clampStepEnabled.store(enableClampStep,std::memory_order_release);
 	}
 
 	inline void System::useConstantStep(float constantStep)
 	{
-		stepMode = STEP_MODE_CONSTANT;
-		System::constantStep = constantStep;
+		System::constantStep.store(constantStep,std::memory_order_relaxed);
+		stepMode.store(STEP_MODE_CONSTANT,std::memory_order_release);
 	}
 
 	inline void System::useAdaptiveStep(float minStep,float maxStep)
 	{
-		stepMode = STEP_MODE_ADAPTIVE;
-		System::minStep = minStep;
-		System::maxStep = maxStep;
+		System::minStep.store(minStep,std::memory_order_relaxed);
+		System::maxStep.store(maxStep,std::memory_order_relaxed);
+		stepMode.store(STEP_MODE_ADAPTIVE,std::memory_order_release);
 	}
 
 	inline void System::useRealStep()
 	{
-		stepMode = STEP_MODE_REAL;
+		stepMode.store(STEP_MODE_REAL,std::memory_order_release);
 	}
 
 	inline StepMode System::getStepMode()
 	{
-		return stepMode;
+		return stepMode.load(std::memory_order_acquire);
 	}
 
 	inline bool System::isInitialized() const
@@ -21,6 +21,8 @@
 // 3. This notice may not be removed or altered from any source distribution.
 //
 
+#include <sstream>
+
 #include <SPARK_Core.h>
 #include "Extensions/IOConverters/SPK_IO_SPKLoader.h"
 
@@ -34,11 +36,11 @@ namespace IO
 	const size_t SPKLoader::DATA_LENGTH_OFFSET = 4;
 	const size_t SPKLoader::HEADER_LENGTH = 12;
 
-    bool SPKLoader::innerLoadFromBuffer(Graph& graph, const char * data, unsigned int datasize)
-    {
-        // Not implemented.
-        return false;
-    }
+	bool SPKLoader::innerLoadFromBuffer(Graph& graph, const char * data, unsigned int datasize)
+	{
+		std::istringstream is(std::string(data,datasize),std::ios::in | std::ios::binary);
+		return innerLoad(is,graph,"");
+	}
 
     bool SPKLoader::innerLoad(std::istream& is, Graph& graph, const std::string &path) const
 	{
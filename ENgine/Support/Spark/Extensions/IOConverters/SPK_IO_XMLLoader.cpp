@@ -39,8 +39,7 @@ namespace IO
     bool XMLLoader::innerLoad(std::istream& is,Graph& graph,const std::string& path) const
 	{
 		pugi::xml_document doc;
-        //pugi::xml_parse_result result = doc.doc.load(is);
-        pugi::xml_parse_result result = doc.load_file(path.c_str());
+		pugi::xml_parse_result result = path.empty() ? doc.load(is) : doc.load_file(path.c_str());
 
 		if (!result)
 		{
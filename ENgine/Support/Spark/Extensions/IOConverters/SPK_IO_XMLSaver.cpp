@@ -58,8 +58,11 @@ namespace IO
 				if (!writeNode(root,*node,graph))
 					return false;
 
-        //doc.save(os,layout.indent.c_str(),layout.lineBreak ? (pugi::format_default) : (pugi::format_default | pugi::format_raw));
-        doc.save_file(filepath.c_str(),layout.indent.c_str(),layout.lineBreak ? (pugi::format_default) : (pugi::format_default | pugi::format_raw));
+		unsigned int format = layout.lineBreak ? (pugi::format_default) : (pugi::format_default | pugi::format_raw);
+		if (filepath.empty())
+			doc.save(os,layout.indent.c_str(),format);
+		else
+			doc.save_file(filepath.c_str(),layout.indent.c_str(),format);
 		return true;
 	}
 
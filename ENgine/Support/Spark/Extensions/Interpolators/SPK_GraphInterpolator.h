@@ -25,6 +25,7 @@
 #define H_SPK_GRAPHINTERPOLATOR
 
 #include <cmath> // for std::abs
+#include <algorithm> // for std::min
 #include <set>
 
 namespace SPK
@@ -255,6 +256,10 @@ namespace SPK
 		static const size_t SCALE_X_DATA_INDEX = 1;
 		static const size_t RATIO_Y_DATA_INDEX = 2;
 
+		// graphs up to this size are flattened into arrays and x is computed by blocks with vectorized kernels
+		static const size_t MAX_FLAT_ENTRIES = 16;
+		static const size_t BLOCK_SIZE = 256;
+
 		std::set<InterpolatorEntry<T> > graph;
 
 		InterpolationType type;
@@ -548,10 +553,79 @@ namespace SPK
 		FloatArrayData& scaleXData = SPK_GET_DATA(FloatArrayData,dataSet,SCALE_X_DATA_INDEX);
 		FloatArrayData& ratioYData = SPK_GET_DATA(FloatArrayData,dataSet,RATIO_Y_DATA_INDEX);
 
-		for (GroupIterator particleIt(group); !particleIt.end(); ++particleIt)
+		if (graph.size() > MAX_FLAT_ENTRIES || (type != INTERPOLATOR_LIFETIME && type != INTERPOLATOR_AGE))
+		{
+			for (GroupIterator particleIt(group); !particleIt.end(); ++particleIt)
+			{
+				size_t index = particleIt->getIndex();
+				interpolateParticle(data[index],*particleIt,offsetXData[index],scaleXData[index],ratioYData[index]);
+			}
+			return;
+		}
+
+		const InterpolatorEntry<T>* entries[MAX_FLAT_ENTRIES];
+		float keys[MAX_FLAT_ENTRIES];
+		size_t nbEntries = 0;
+
+		for (typename std::set<InterpolatorEntry<T> >::const_iterator it = graph.begin(); it != graph.end(); ++it)
 		{
-			size_t index = particleIt->getIndex();
-			interpolateParticle(data[index],*particleIt,offsetXData[index],scaleXData[index],ratioYData[index]);
+			entries[nbEntries] = &*it;
+			keys[nbEntries] = it->x;
+			++nbEntries;
+		}
+
+		// x is 1 - energy for life time and age otherwise
+		const bool lifeTime = type == INTERPOLATOR_LIFETIME;
+		const float* base = static_cast<const float*>(lifeTime ? group.getEnergyAddress() : group.getAgeAddress());
+		const float bias = lifeTime ? 1.0f : 0.0f;
+		const float sign = lifeTime ? -1.0f : 1.0f;
+
+		float x[BLOCK_SIZE];
+		size_t nbParticles = group.getNbParticles();
+
+		for (size_t start = 0; start < nbParticles; start += BLOCK_SIZE)
+		{
+			size_t nb = nbParticles - start < BLOCK_SIZE ? nbParticles - start : BLOCK_SIZE;
+
+			computeGraphX(x,base + start,bias,sign,offsetXData.getData() + start,scaleXData.getData() + start,nb);
+
+			if (loopingEnabled && nbEntries >= 2)
+				wrapGraphX(x,keys[0],keys[nbEntries - 1] - keys[0],nb);
+
+			for (size_t i = 0; i < nb; ++i)
+			{
+				size_t index = start + i;
+				float ratioY = ratioYData[index];
+
+				// If the graph has less than 2 entries, we cannot loop
+				if (loopingEnabled && nbEntries < 2)
+				{
+					interpolateEntry(data[index],*entries[0],ratioY);
+					continue;
+				}
+
+				// Finds the entry that is immediatly after the current X
+				size_t next = 0;
+				while (next < nbEntries && keys[next] <= x[i])
+					++next;
+
+				if (next == nbEntries)
+					interpolateEntry(data[index],*entries[nbEntries - 1],ratioY);
+				else if (next == 0)
+					interpolateEntry(data[index],*entries[0],ratioY);
+				else
+				{
+					const InterpolatorEntry<T>& nextEntry = *entries[next];
+					const InterpolatorEntry<T>& previousEntry = *entries[next - 1];
+					float ratioX = (x[i] - previousEntry.x) / (nextEntry.x - previousEntry.x);
+					T y0,y1;
+
+					interpolateEntry(y0,previousEntry,ratioY);
+					interpolateEntry(y1,nextEntry,ratioY);
+
+					this->interpolateParam(data[index],y0,y1,ratioX);
+				}
+			}
 		}
 	}
 
@@ -605,7 +679,7 @@ namespace SPK
 				validGraph = false;
 		}
 
-		if (validGraph && (attrib = descriptor.getAttributeWithValue("graph values")))
+		if (validGraph && (attrib = descriptor.getAttributeWithValue("graph values 2")))
 		{
 			std::vector<T> values1 = attrib->getValues<T>();
 			if (values1.size() == nbEntries)
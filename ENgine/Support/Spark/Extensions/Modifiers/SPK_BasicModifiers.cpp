@@ -31,8 +31,7 @@ namespace SPK
 	void Gravity::modify(Group& group,DataSet* dataSet,float deltaTime) const
 	{
 		const Vector3D discreteGravity = tValue * deltaTime;
-		for (GroupIterator particleIt(group); !particleIt.end(); ++particleIt)
-			particleIt->velocity() += discreteGravity;
+		addToVectors(static_cast<Vector3D*>(group.getVelocityAddressNC()),discreteGravity,group.getNbParticles());
 	}
 
 	void Friction::modify(Group& group,DataSet* dataSet,float deltaTime) const
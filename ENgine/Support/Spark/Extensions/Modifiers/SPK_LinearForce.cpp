@@ -159,7 +159,12 @@ namespace SPK
 		{
 			const Vector3D discreteForce = tValue * deltaTime * realCoef;
 
-			if (!factorByParticle)
+			if (!factorByParticle && getZoneTest() == ZONE_TEST_ALWAYS)
+			{
+				// every particle passes the test, so the force is added to all velocities at once
+				addToVectors(static_cast<Vector3D*>(group.getVelocityAddressNC()),discreteForce,group.getNbParticles());
+			}
+			else if (!factorByParticle)
 			{
 				for (GroupIterator particleIt(group); !particleIt.end(); ++particleIt)
 					if (checkZone(*particleIt))
@@ -32,6 +32,7 @@
 #include "Core/SPK_Reference.h"
 #include "Core/SPK_Vector3D.h"
 #include "Core/SPK_Color.h"
+#include "Core/SPK_Kernels.h"
 #include "Core/IO/SPK_IO_Descriptor.h"
 #include "Core/IO/SPK_IO_Attribute.h"
 #include "Core/SPK_Transform.h"
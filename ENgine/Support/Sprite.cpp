@@ -30,17 +30,81 @@ namespace Oak::Sprite
 		};
 	};
 
+	class BatchProgram : public QuadProgram
+	{
+	public:
+		virtual const char* GetVsName() { return "sprite_batch_vs.shd"; };
+		virtual const char* GetPsName() { return "sprite_batch_ps.shd"; };
+	};
+
+	class BatchProgramNoZ : public QuadProgramNoZ
+	{
+	public:
+		virtual const char* GetVsName() { return "sprite_batch_vs.shd"; };
+		virtual const char* GetPsName() { return "sprite_batch_ps.shd"; };
+	};
+
 	CLASSREGEX(Program, QuadProgram, QuadProgram, "QuadProgram")
 	CLASSREGEX_END(Program, QuadProgram)
 
 	CLASSREGEX(Program, QuadProgramNoZ, QuadProgramNoZ, "QuadProgramNoZ")
 	CLASSREGEX_END(Program, QuadProgramNoZ)
 
+	CLASSREGEX(Program, BatchProgram, BatchProgram, "SpriteBatchProgram")
+	CLASSREGEX_END(Program, BatchProgram)
+
+	CLASSREGEX(Program, BatchProgramNoZ, BatchProgramNoZ, "SpriteBatchProgramNoZ")
+	CLASSREGEX_END(Program, BatchProgramNoZ)
+
+	struct BatchVertex
+	{
+		Math::Vector3 pos;
+		Math::Vector2 uv;
+		uint32_t color;
+	};
+
+	struct QuadParams
+	{
+		Program::Param desc;
+		Program::Param trans;
+		Program::Param viewProj;
+		Program::Param color;
+		Program::Param diffuseMap;
+
+		void Init(Program* prg)
+		{
+			desc = prg->GetParam(ShaderType::Vertex, "desc");
+			trans = prg->GetParam(ShaderType::Vertex, "trans");
+			viewProj = prg->GetParam(ShaderType::Vertex, "view_proj");
+			color = prg->GetParam(ShaderType::Pixel, "color");
+			diffuseMap = prg->GetParam(ShaderType::Pixel, "diffuseMap");
+		}
+	};
+
+	constexpr int maxBatchQuads = 2048;
+
 	ProgramRef quadPrg;
 	ProgramRef quadPrgNoZ;
+	QuadParams quadParams;
+	QuadParams quadParamsNoZ;
 	VertexDeclRef vdecl;
 	DataBufferRef buffer;
 
+	// quads are collected into batch and drawn by one draw call per run of same texture, depth mode and view projection
+	bool batchSupported = false;
+	ProgramRef batchPrg;
+	ProgramRef batchPrgNoZ;
+	QuadParams batchParams;
+	QuadParams batchParamsNoZ;
+	VertexDeclRef batchVdecl;
+	DataBufferRef batchBuffer;
+	DataBufferRef batchIndices;
+	eastl::vector<BatchVertex> batchVertices;
+	int batchQuads = 0;
+	Texture* batchTexture = nullptr;
+	bool batchUseDepth = true;
+	Math::Matrix batchViewProj;
+
 	float pixelsPerUnit = 50.0f;
 	float pixelsPerUnitInvert = 1.0f / pixelsPerUnit;
 	float pixelsHeight = 1080.0f;
@@ -64,14 +128,88 @@ namespace Oak::Sprite
 
 		quadPrg = root.render.GetProgram("QuadProgram", _FL_);
 		quadPrgNoZ = root.render.GetProgram("QuadProgramNoZ", _FL_);
+		quadParams.Init(quadPrg);
+		quadParamsNoZ.Init(quadPrgNoZ);
+
+		batchPrg = root.render.GetProgram("SpriteBatchProgram", _FL_);
+		batchPrgNoZ = root.render.GetProgram("SpriteBatchProgramNoZ", _FL_);
+
+		// without compiled batch shaders every quad is drawn separately as before
+		batchSupported = batchPrg->IsLoaded() && batchPrgNoZ->IsLoaded();
+
+		if (!batchSupported)
+		{
+			return;
+		}
+
+		batchParams.Init(batchPrg);
+		batchParamsNoZ.Init(batchPrgNoZ);
+
+		VertexDecl::ElemDesc batchDesc[] = { { ElementType::Float3, ElementSemantic::Position, 0 }, { ElementType::Float2, ElementSemantic::Texcoord, 0 }, { ElementType::Ubyte4, ElementSemantic::Color, 0 } };
+		batchVdecl = root.render.GetDevice()->CreateVertexDecl(3, batchDesc, _FL_);
+
+		batchBuffer = root.render.GetDevice()->CreateBuffer(maxBatchQuads * 4, sizeof(BatchVertex), _FL_);
+		batchIndices = root.render.GetDevice()->CreateBuffer(maxBatchQuads * 6, sizeof(uint16_t), _FL_);
+
+		uint16_t* indices = (uint16_t*)batchIndices->Lock();
+
+		for (int i = 0; i < maxBatchQuads; i++)
+		{
+			uint16_t base = (uint16_t)(i * 4);
+
+			indices[i * 6 + 0] = base + 0;
+			indices[i * 6 + 1] = base + 1;
+			indices[i * 6 + 2] = base + 2;
+			indices[i * 6 + 3] = base + 2;
+			indices[i * 6 + 4] = base + 1;
+			indices[i * 6 + 5] = base + 3;
+		}
+
+		batchIndices->Unlock();
+
+		batchVertices.resize(maxBatchQuads * 4);
+
+		root.render.GetDevice()->SetBatchFlusher(Flush);
 	}
 
-	void Draw(Texture* texture, Color clr, Math::Matrix trans, Math::Vector2 pos, Math::Vector2 size, Math::Vector2 uv, Math::Vector2 duv, bool useDepth)
+	void Flush()
+	{
+		int count = batchQuads;
+
+		// device calls below can request flush again, so batch is marked as empty before them
+		batchQuads = 0;
+
+		if (count == 0)
+		{
+			return;
+		}
+
+		Device* device = root.render.GetDevice();
+
+		BatchVertex* vertices = (BatchVertex*)batchBuffer->Lock();
+		memcpy(vertices, batchVertices.data(), sizeof(BatchVertex) * 4 * count);
+		batchBuffer->Unlock();
+
+		ProgramRef prg = batchUseDepth ? batchPrg : batchPrgNoZ;
+		QuadParams& params = batchUseDepth ? batchParams : batchParamsNoZ;
+		device->SetProgram(prg);
+		device->SetVertexDecl(batchVdecl);
+		device->SetVertexBuffer(0, batchBuffer);
+		device->SetIndexBuffer(batchIndices);
+
+		prg->SetMatrix(params.viewProj, &batchViewProj, 1);
+		prg->SetTexture(params.diffuseMap, batchTexture ? batchTexture : root.render.GetWhiteTexture());
+
+		device->DrawIndexed(PrimitiveTopology::TrianglesList, 0, 0, count * 2);
+	}
+
+	void DrawQuad(Texture* texture, Color clr, Math::Matrix trans, Math::Vector2 pos, Math::Vector2 size, Math::Vector2 uv, Math::Vector2 duv, bool useDepth)
 	{
 		root.render.GetDevice()->SetVertexBuffer(0, buffer);
 		root.render.GetDevice()->SetVertexDecl(vdecl);
 
 		ProgramRef prg = useDepth ? quadPrg : quadPrgNoZ;
+		QuadParams& prgParams = useDepth ? quadParams : quadParamsNoZ;
 		root.render.GetDevice()->SetProgram(prg);
 
 		Device::Viewport viewport;
@@ -87,17 +225,78 @@ namespace Oak::Sprite
 
 		trans.Pos() *= pixelsPerUnitInvert;
 
-		prg->SetVector(ShaderType::Vertex, "desc", &params[0], 3);
-		prg->SetMatrix(ShaderType::Vertex, "trans", &trans, 1);
-		prg->SetMatrix(ShaderType::Vertex, "view_proj", &view_proj, 1);
-		prg->SetVector(ShaderType::Pixel, "color", (Math::Vector4*)&clr.r, 1);
-		prg->SetTexture(ShaderType::Pixel, "diffuseMap", texture ? texture : root.render.GetWhiteTexture());
+		prg->SetVector(prgParams.desc, &params[0], 3);
+		prg->SetMatrix(prgParams.trans, &trans, 1);
+		prg->SetMatrix(prgParams.viewProj, &view_proj, 1);
+		prg->SetVector(prgParams.color, (Math::Vector4*)&clr.r, 1);
+		prg->SetTexture(prgParams.diffuseMap, texture ? texture : root.render.GetWhiteTexture());
 
 		root.render.GetDevice()->Draw(PrimitiveTopology::TriangleStrip, 0, 2);
 	}
 
+	void Draw(Texture* texture, Color clr, Math::Matrix trans, Math::Vector2 pos, Math::Vector2 size, Math::Vector2 uv, Math::Vector2 duv, bool useDepth)
+	{
+		if (!batchSupported)
+		{
+			DrawQuad(texture, clr, trans, pos, size, uv, duv, useDepth);
+			return;
+		}
+
+		Math::Matrix viewProj;
+		root.render.GetTransform(TransformStage::WrldViewProj, viewProj);
+
+		if (batchQuads > 0 && (batchQuads == maxBatchQuads || batchTexture != texture || batchUseDepth != useDepth ||
+		                       memcmp(&batchViewProj, &viewProj, sizeof(Math::Matrix)) != 0))
+		{
+			Flush();
+		}
+
+		batchTexture = texture;
+		batchUseDepth = useDepth;
+		batchViewProj = viewProj;
+
+		trans.Pos() *= pixelsPerUnitInvert;
+
+		uint32_t color = clr.Get();
+
+		// same order of corners as in triangle strip of a single quad
+		const float corners[4][2] = { { 0.0f, 1.0f }, { 1.0f, 1.0f }, { 0.0f, 0.0f }, { 1.0f, 0.0f } };
+
+		BatchVertex* vertices = &batchVertices[batchQuads * 4];
+
+		for (int i = 0; i < 4; i++)
+		{
+			float cx = corners[i][0];
+			float cy = corners[i][1];
+
+			Math::Vector3 local((pos.x + size.x * cx) * pixelsPerUnitInvert, (pos.y - size.y * cy) * pixelsPerUnitInvert, 0.0f);
+
+			vertices[i].pos = trans.MulVertex(local);
+			vertices[i].uv = Math::Vector2(uv.x + duv.x * cx, uv.y + duv.y * cy);
+			vertices[i].color = color;
+		}
+
+		batchQuads++;
+
+		root.render.GetDevice()->MarkBatchPending();
+	}
+
 	void Release()
 	{
+		if (batchSupported)
+		{
+			root.render.GetDevice()->SetBatchFlusher(nullptr);
+		}
+
+		batchQuads = 0;
+		batchSupported = false;
+		batchVertices.clear();
+		batchVdecl.ReleaseRef();
+		batchBuffer.ReleaseRef();
+		batchIndices.ReleaseRef();
+		batchPrg.ReleaseRef();
+		batchPrgNoZ.ReleaseRef();
+
 		vdecl.ReleaseRef();
 		buffer.ReleaseRef();
 		quadPrg.ReleaseRef();
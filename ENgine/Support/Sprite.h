@@ -19,6 +19,7 @@ namespace Oak::Sprite
 
 	void Init();
 	void Draw(Texture* texture, Color clr, Math::Matrix trans, Math::Vector2 pos, Math::Vector2 size, Math::Vector2 uv, Math::Vector2 duv, bool useDepth);
+	void Flush();
 	void Release();
 }
 #endif
\ No newline at end of file
@@ -31,6 +31,34 @@ namespace Oak
 	#endif
 	}
 
+	ThreadSemaphore::ThreadSemaphore()
+	{
+	#ifdef PLATFORM_WIN
+		semaphore = CreateSemaphoreA(nullptr, 0, 0x7fffffff, nullptr);
+	#endif
+	}
+
+	ThreadSemaphore::~ThreadSemaphore()
+	{
+	#ifdef PLATFORM_WIN
+		CloseHandle(semaphore);
+	#endif
+	}
+
+	void ThreadSemaphore::Wait()
+	{
+	#ifdef PLATFORM_WIN
+		WaitForSingleObject(semaphore, INFINITE);
+	#endif
+	}
+
+	void ThreadSemaphore::Release(int count)
+	{
+	#ifdef PLATFORM_WIN
+		ReleaseSemaphore(semaphore, count, nullptr);
+	#endif
+	}
+
 	void ThreadExecutor::Execute(ThreadCaller* caller, ThreadCaller::Delegate call)
 	{
 		this->caller = caller;
@@ -77,6 +105,18 @@ namespace Oak
 	#endif
 	}
 
+	int ThreadExecutor::GetCoresCount()
+	{
+	#ifdef PLATFORM_WIN
+		SYSTEM_INFO info;
+		GetSystemInfo(&info);
+
+		return (int)info.dwNumberOfProcessors;
+	#else
+		return 1;
+	#endif
+	}
+
 	#ifdef PLATFORM_WIN
 	DWORD WINAPI ThreadExecutor::Entry(void* arg)
 	{
@@ -43,6 +43,40 @@ namespace Oak
 	#endif
 	};
 
+	/**
+	\brief Wrapper around semaphore
+
+	This class wraps semaphore and allows to work with semaphore via platform independent inteface.
+
+	*/
+
+	class ThreadSemaphore
+	{
+	public:
+		ThreadSemaphore();
+		~ThreadSemaphore();
+
+		/**
+		\brief Wait until semaphore will be signaled
+		*/
+
+		void Wait();
+
+		/**
+		\brief Signal semaphore
+
+		\param[in] count How many waiting threads should be woken up
+		*/
+
+		void Release(int count);
+	#ifndef DOXYGEN_SKIP
+	private:
+	#ifdef PLATFORM_WIN
+		HANDLE semaphore;
+	#endif
+	#endif
+	};
+
 	class ThreadCaller
 	{
 	public:
@@ -97,6 +131,13 @@ namespace Oak
 
 		static void Sleep(int mili_sec);
 
+		/**
+		\brief Get count of logical cores
+
+		\return Count of logical cores
+		*/
+		static int GetCoresCount();
+
 	#ifndef DOXYGEN_SKIP
 	private:
 		ThreadCaller* caller;
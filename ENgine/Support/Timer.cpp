@@ -1,10 +1,10 @@
 #include "Timer.h"
 #include <stdio.h>
 #include "stb_sprintf.h"
+#include <time.h>
 
 #ifdef PLATFORM_WIN
 #define WIN32_LEAN_AND_MEAN
-#include <time.h>
 #include <Windows.h>
 #endif
 
@@ -58,6 +58,8 @@ namespace Oak::Timer
 
 		#ifdef PLATFORM_WIN
 		clock_gettime(&currTime);
+		#else
+		::clock_gettime(CLOCK_MONOTONIC, &currTime);
 		#endif
 
 		if (lastTime < -0.5)
@@ -117,4 +119,17 @@ namespace Oak::Timer
 	{
 		return stampStr;
 	}
+
+	double GetTime()
+	{
+		struct timespec currTime = {};
+
+		#ifdef PLATFORM_WIN
+		clock_gettime(&currTime);
+		#else
+		::clock_gettime(CLOCK_MONOTONIC, &currTime);
+		#endif
+
+		return (double)currTime.tv_sec + (double)currTime.tv_nsec / 1000000000.0;
+	}
 }
@@ -10,4 +10,5 @@ namespace Oak::Timer
 	float GetDeltaTime();
 	int GetFPS();
 	const char* GetTimeStamp();
+	double GetTime();
 }
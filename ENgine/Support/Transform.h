@@ -3,6 +3,8 @@
 
 #include "Root/Files/JsonReader.h"
 #include "Root/Files/JsonWriter.h"
+#include "Root/Files/BinaryReader.h"
+#include "Root/Files/BinaryWriter.h"
 
 /**
 \ingroup gr_code_common
@@ -174,5 +176,33 @@ namespace Oak
 			writer.Write("offset", offset);
 			writer.FinishBlock();
 		};
+
+		/**
+		\brief Load data of transform from binary file
+
+		\param[in] reader Helper class for reading binary file
+		*/
+		void Load(BinaryReader& reader)
+		{
+			reader.Read(position);
+			reader.Read(rotation);
+			reader.Read(scale);
+			reader.Read(size);
+			reader.Read(offset);
+		};
+
+		/**
+		\brief Save data of transform into binary file
+
+		\param[in] writer Helper class for writing binary file
+		*/
+		void Save(BinaryWriter& writer)
+		{
+			writer.Write(position);
+			writer.Write(rotation);
+			writer.Write(scale);
+			writer.Write(size);
+			writer.Write(offset);
+		};
 	};
 }
\ No newline at end of file